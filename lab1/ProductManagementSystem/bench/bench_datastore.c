@@ -0,0 +1,375 @@
+/**
+ * @file bench_datastore.c
+ * @brief Microbenchmarks for the core DataStore operations
+ * @author PMS Team
+ * @date 2025
+ * @compatible Dev-C++ 6.3, TDM-GCC 9.2.0, C11
+ *
+ * For each catalog size, builds a store and times add, lookup, the three
+ * searches, statistics, save and load. Every result is one CSV row (or one
+ * JSON object per line with --json) on stdout:
+ *
+ *   benchmark,size,ops,total_ns,ns_per_op,ops_per_sec,items_per_sec
+ *
+ * items_per_sec counts products touched (scanned, written or read), so
+ * full-scan operations can be compared across sizes.
+ *
+ * Usage: bench_datastore [--sizes 1000,10000,...] [--threads N] [--min-time SEC]
+ *                        [--dir PATH] [--json] [--quick]
+ */
+
+#include "../include/utils.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define MAX_SIZES 16
+#define PRODUCTS_PER_SUBGROUP 1000     // Below the load limit of 10000 per subgroup
+#define SUBGROUPS_PER_CATEGORY 100
+#define LOOKUPS_PER_ROUND 100000
+
+typedef struct {
+    long long sizes[MAX_SIZES];
+    int size_count;
+    int threads;
+    double min_time;           // Seconds each benchmark keeps repeating for
+    const char* dir;
+    bool json;
+} BenchOptions;
+
+// ============================================================================
+// Timing and Reporting
+// ============================================================================
+
+static long long now_ns(void) {
+    struct timespec ts;
+    #ifdef CLOCK_MONOTONIC
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    #else
+    timespec_get(&ts, TIME_UTC);
+    #endif
+    return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+static void report(const BenchOptions* options, const char* name, long long size,
+                   long long ops, long long total_ns, long long items) {
+    double ns_per_op = ops > 0 ? (double)total_ns / ops : 0.0;
+    double seconds = total_ns / 1e9;
+    double ops_per_sec = seconds > 0 ? ops / seconds : 0.0;
+    double items_per_sec = seconds > 0 ? items / seconds : 0.0;
+
+    if (options->json) {
+        printf("{\"benchmark\":\"%s\",\"size\":%lld,\"ops\":%lld,\"total_ns\":%lld,"
+               "\"ns_per_op\":%.1f,\"ops_per_sec\":%.1f,\"items_per_sec\":%.1f}\n",
+               name, size, ops, total_ns, ns_per_op, ops_per_sec, items_per_sec);
+    } else {
+        printf("%s,%lld,%lld,%lld,%.1f,%.1f,%.1f\n",
+               name, size, ops, total_ns, ns_per_op, ops_per_sec, items_per_sec);
+    }
+    fflush(stdout);
+}
+
+/**
+ * @brief Repeat a full-catalog operation until min_time has passed
+ */
+typedef void (*RoundFunc)(DataStore* store, void* arg);
+
+static void bench_rounds(const BenchOptions* options, const char* name, DataStore* store,
+                         long long size, RoundFunc round, void* arg) {
+    round(store, arg);         // Warm-up: builds the scan table, faults in pages
+
+    long long ops = 0;
+    long long start = now_ns();
+    long long elapsed;
+    do {
+        round(store, arg);
+        ops++;
+        elapsed = now_ns() - start;
+    } while (elapsed < (long long)(options->min_time * 1e9));
+
+    report(options, name, size, ops, elapsed, ops * size);
+}
+
+// ============================================================================
+// Catalog Generation
+// ============================================================================
+
+static unsigned int rng_state = 12345u;
+
+static unsigned int next_random(void) {
+    rng_state = rng_state * 1664525u + 1013904223u;
+    return rng_state >> 8;
+}
+
+static Product make_product(int id, int subgroup_id) {
+    char code[20];
+    char name[64];
+    snprintf(code, sizeof(code), "P%08d", id);
+    snprintf(name, sizeof(name), "Item %u model %d", next_random() % 1000, id);
+
+    float price = (float)(next_random() % 100000) / 100.0f;
+    int quantity = (int)(next_random() % 1000);
+    return product_create(id, subgroup_id, code, name, "Benchmark product", price, quantity);
+}
+
+static void bench_subgroup_add(const BenchOptions* options, long long size) {
+    Subgroup subgroup = subgroup_create(1, 1, "Bench", "Raw subgroup_add_product");
+    Product product = make_product(1, 1);
+
+    long long start = now_ns();
+    for (long long i = 0; i < size; i++) {
+        product.id = (int)(i + 1);
+        subgroup_add_product(&subgroup, product);
+    }
+    long long elapsed = now_ns() - start;
+
+    report(options, "subgroup_add_product", size, size, elapsed, size);
+    subgroup_free(&subgroup);
+}
+
+/**
+ * @brief Build a store of size products; times datastore_add_product on the way
+ */
+static bool build_store(const BenchOptions* options, DataStore* store, long long size) {
+    *store = datastore_init();
+    store->quiet = true;
+    if (options->threads != 1 && !datastore_set_thread_count(store, options->threads)) {
+        return false;
+    }
+
+    long long subgroup_count = (size + PRODUCTS_PER_SUBGROUP - 1) / PRODUCTS_PER_SUBGROUP;
+    int* subgroup_ids = (int*)malloc((size_t)subgroup_count * sizeof(int));
+    if (!subgroup_ids) return false;
+
+    int category_id = 0;
+    for (long long s = 0; s < subgroup_count; s++) {
+        if (s % SUBGROUPS_PER_CATEGORY == 0) {
+            category_id = datastore_allocate_id(store, ID_CATEGORY);
+            if (!datastore_add_category(store, category_create(category_id, "Bench", "Benchmark"))) {
+                free(subgroup_ids);
+                return false;
+            }
+        }
+
+        subgroup_ids[s] = datastore_allocate_id(store, ID_SUBGROUP);
+        Subgroup subgroup = subgroup_create(subgroup_ids[s], category_id, "Bench", "Benchmark");
+        if (!datastore_add_subgroup(store, category_id, subgroup)) {
+            free(subgroup_ids);
+            return false;
+        }
+    }
+
+    // Products are generated in untimed chunks so only the add is measured
+    Product* chunk = (Product*)malloc(PRODUCTS_PER_SUBGROUP * sizeof(Product));
+    if (!chunk) {
+        free(subgroup_ids);
+        return false;
+    }
+
+    bool ok = true;
+    long long elapsed = 0;
+    for (long long s = 0; s < subgroup_count && ok; s++) {
+        long long first = s * PRODUCTS_PER_SUBGROUP;
+        int count = (int)(size - first < PRODUCTS_PER_SUBGROUP ? size - first : PRODUCTS_PER_SUBGROUP);
+
+        for (int i = 0; i < count; i++) {
+            chunk[i] = make_product(datastore_allocate_id(store, ID_PRODUCT), subgroup_ids[s]);
+        }
+
+        long long start = now_ns();
+        for (int i = 0; i < count && ok; i++) {
+            ok = datastore_add_product(store, subgroup_ids[s], chunk[i]);
+        }
+        elapsed += now_ns() - start;
+    }
+
+    if (ok) {
+        report(options, "datastore_add_product", size, size, elapsed, size);
+    }
+
+    free(chunk);
+    free(subgroup_ids);
+    return ok;
+}
+
+// ============================================================================
+// Benchmarks
+// ============================================================================
+
+static void bench_find(const BenchOptions* options, DataStore* store, long long size) {
+    long long lookups = size < LOOKUPS_PER_ROUND ? size : LOOKUPS_PER_ROUND;
+    int* ids = (int*)malloc((size_t)lookups * sizeof(int));
+    if (!ids) return;
+
+    for (long long i = 0; i < lookups; i++) {
+        ids[i] = 1 + (int)(next_random() % (unsigned int)size);
+    }
+
+    long long ops = 0;
+    long long found = 0;
+    long long start = now_ns();
+    long long elapsed;
+    do {
+        for (long long i = 0; i < lookups; i++) {
+            found += datastore_find_product_by_id(store, ids[i]) != NULL;
+        }
+        ops += lookups;
+        elapsed = now_ns() - start;
+    } while (elapsed < (long long)(options->min_time * 1e9));
+
+    if (found != ops) {
+        fprintf(stderr, "Error: %lld lookups missed\n", ops - found);
+    }
+    report(options, "datastore_find_product_by_id", size, ops, elapsed, ops);
+    free(ids);
+}
+
+static void round_search_name(DataStore* store, void* arg) {
+    (void)arg;
+    SearchResult result = datastore_search_products_by_name(store, "item 42 ");
+    search_result_free(&result);
+}
+
+static void round_search_price(DataStore* store, void* arg) {
+    (void)arg;
+    SearchResult result = datastore_search_products_by_price(store, 100.0f, 110.0f);
+    search_result_free(&result);
+}
+
+static void round_search_quantity(DataStore* store, void* arg) {
+    (void)arg;
+    SearchResult result = datastore_search_products_by_quantity(store, 10, 19);
+    search_result_free(&result);
+}
+
+static void round_statistics(DataStore* store, void* arg) {
+    (void)arg;
+    volatile Statistics stats = datastore_get_statistics(store);
+    (void)stats;
+}
+
+static void round_save(DataStore* store, void* arg) {
+    datastore_save(store, (const char*)arg);
+}
+
+static void bench_load(const BenchOptions* options, const char* path, long long size) {
+    DataStore store = datastore_init();
+    store.quiet = true;
+
+    long long ops = 0;
+    long long start = now_ns();
+    long long elapsed = 0;
+    while (elapsed < (long long)(options->min_time * 1e9) && datastore_load(&store, path)) {
+        ops++;
+        elapsed = now_ns() - start;
+    }
+
+    if (ops > 0) {
+        report(options, "datastore_load", size, ops, elapsed, ops * size);
+    } else {
+        fprintf(stderr, "Error: Failed to load %s\n", path);
+    }
+    datastore_free(&store);
+}
+
+static bool bench_size(const BenchOptions* options, long long size) {
+    bench_subgroup_add(options, size);
+
+    DataStore store;
+    if (!build_store(options, &store, size)) {
+        fprintf(stderr, "Error: Failed to build a catalog of %lld products\n", size);
+        datastore_free(&store);
+        return false;
+    }
+
+    bench_find(options, &store, size);
+    bench_rounds(options, "datastore_search_products_by_name", &store, size, round_search_name, NULL);
+    bench_rounds(options, "datastore_search_products_by_price", &store, size, round_search_price, NULL);
+    bench_rounds(options, "datastore_search_products_by_quantity", &store, size, round_search_quantity, NULL);
+    bench_rounds(options, "datastore_get_statistics", &store, size, round_statistics, NULL);
+
+    char path[512];
+    snprintf(path, sizeof(path), "%s/pms_bench_%lld.dat", options->dir, size);
+    bench_rounds(options, "datastore_save", &store, size, round_save, path);
+    datastore_free(&store);
+
+    bench_load(options, path, size);
+
+    char backup[512];
+    snprintf(backup, sizeof(backup), "%s/pms_bench_%lld.bak", options->dir, size);
+    remove(path);
+    remove(backup);
+    return true;
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+static bool parse_sizes(BenchOptions* options, const char* list) {
+    options->size_count = 0;
+    const char* p = list;
+
+    while (*p) {
+        char* end;
+        long long size = strtoll(p, &end, 10);
+        if (end == p || size <= 0 || size > 100000000LL || options->size_count >= MAX_SIZES) {
+            return false;
+        }
+
+        options->sizes[options->size_count++] = size;
+        p = *end == ',' ? end + 1 : end;
+        if (*end != ',' && *end != '\0') return false;
+    }
+    return options->size_count > 0;
+}
+
+static void print_usage(const char* program) {
+    fprintf(stderr, "Usage: %s [--sizes 1000,10000,...] [--threads N] [--min-time SEC]\n", program);
+    fprintf(stderr, "          [--dir PATH] [--json] [--quick]\n");
+    fprintf(stderr, "Default sizes: 1000,10000,100000,1000000 (10000000 needs about 10 GB)\n");
+}
+
+int main(int argc, char* argv[]) {
+    BenchOptions options;
+    parse_sizes(&options, "1000,10000,100000,1000000");
+    options.threads = 1;
+    options.min_time = 0.5;
+    options.dir = ".";
+    options.json = false;
+
+    for (int i = 1; i < argc; i++) {
+        bool has_value = i + 1 < argc;
+
+        if (strcmp(argv[i], "--sizes") == 0 && has_value) {
+            if (!parse_sizes(&options, argv[++i])) {
+                fprintf(stderr, "Error: Invalid size list %s\n", argv[i]);
+                return 2;
+            }
+        } else if (strcmp(argv[i], "--threads") == 0 && has_value) {
+            options.threads = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--min-time") == 0 && has_value) {
+            options.min_time = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--dir") == 0 && has_value) {
+            options.dir = argv[++i];
+        } else if (strcmp(argv[i], "--json") == 0) {
+            options.json = true;
+        } else if (strcmp(argv[i], "--quick") == 0) {
+            parse_sizes(&options, "1000,100000");
+            options.min_time = 0.05;
+        } else {
+            print_usage(argv[0]);
+            return 2;
+        }
+    }
+
+    if (!options.json) {
+        printf("benchmark,size,ops,total_ns,ns_per_op,ops_per_sec,items_per_sec\n");
+    }
+
+    for (int i = 0; i < options.size_count; i++) {
+        if (!bench_size(&options, options.sizes[i])) return 1;
+    }
+    return 0;
+}
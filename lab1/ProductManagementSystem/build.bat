@@ -22,23 +22,71 @@ echo Compiling source files...
 echo.
 
 REM Compile each module
-echo [1/5] Compiling product.c...
+echo [1/17] Compiling product.c...
 %GCC% %CFLAGS% -c src/product.c -o obj/product.o
 if %errorlevel% neq 0 goto :error
 
-echo [2/5] Compiling subgroup.c...
+echo [2/17] Compiling subgroup.c...
 %GCC% %CFLAGS% -c src/subgroup.c -o obj/subgroup.o
 if %errorlevel% neq 0 goto :error
 
-echo [3/5] Compiling category.c...
+echo [3/17] Compiling category.c...
 %GCC% %CFLAGS% -c src/category.c -o obj/category.o
 if %errorlevel% neq 0 goto :error
 
-echo [4/5] Compiling utils.c...
+echo [4/17] Compiling utils.c...
 %GCC% %CFLAGS% -c src/utils.c -o obj/utils.o
 if %errorlevel% neq 0 goto :error
 
-echo [5/5] Compiling main.c...
+echo [5/17] Compiling handle.c...
+%GCC% %CFLAGS% -c src/handle.c -o obj/handle.o
+if %errorlevel% neq 0 goto :error
+
+echo [6/17] Compiling product_table.c...
+%GCC% %CFLAGS% -c src/product_table.c -o obj/product_table.o
+if %errorlevel% neq 0 goto :error
+
+echo [7/17] Compiling simd_filter.c...
+%GCC% %CFLAGS% -c src/simd_filter.c -o obj/simd_filter.o
+if %errorlevel% neq 0 goto :error
+
+echo [8/17] Compiling thread.c...
+%GCC% %CFLAGS% -c src/thread.c -o obj/thread.o
+if %errorlevel% neq 0 goto :error
+
+echo [9/17] Compiling thread_pool.c...
+%GCC% %CFLAGS% -c src/thread_pool.c -o obj/thread_pool.o
+if %errorlevel% neq 0 goto :error
+
+echo [10/17] Compiling snapshot.c...
+%GCC% %CFLAGS% -c src/snapshot.c -o obj/snapshot.o
+if %errorlevel% neq 0 goto :error
+
+echo [11/17] Compiling sharded_store.c...
+%GCC% %CFLAGS% -c src/sharded_store.c -o obj/sharded_store.o
+if %errorlevel% neq 0 goto :error
+
+echo [12/17] Compiling command.c...
+%GCC% %CFLAGS% -c src/command.c -o obj/command.o
+if %errorlevel% neq 0 goto :error
+
+echo [13/17] Compiling server.c...
+%GCC% %CFLAGS% -c src/server.c -o obj/server.o
+if %errorlevel% neq 0 goto :error
+
+echo [14/17] Compiling metrics.c...
+%GCC% %CFLAGS% -c src/metrics.c -o obj/metrics.o
+if %errorlevel% neq 0 goto :error
+
+echo [15/17] Compiling render.c...
+%GCC% %CFLAGS% -c src/render.c -o obj/render.o
+if %errorlevel% neq 0 goto :error
+
+echo [16/17] Compiling timestamp.c...
+%GCC% %CFLAGS% -c src/timestamp.c -o obj/timestamp.o
+if %errorlevel% neq 0 goto :error
+
+echo [17/17] Compiling main.c...
 %GCC% %CFLAGS% -c src/main.c -o obj/main.o
 if %errorlevel% neq 0 goto :error
 
@@ -46,7 +94,7 @@ echo.
 echo Linking objects...
 
 REM Link all object files
-%GCC% obj/product.o obj/subgroup.o obj/category.o obj/utils.o obj/main.o ^
+%GCC% obj/product.o obj/subgroup.o obj/category.o obj/utils.o obj/handle.o obj/product_table.o obj/simd_filter.o obj/thread.o obj/thread_pool.o obj/snapshot.o obj/sharded_store.o obj/command.o obj/server.o obj/metrics.o obj/render.o obj/timestamp.o obj/main.o ^
       -o ProductManagementSystem.exe -static-libgcc
 
 if %errorlevel% neq 0 goto :error
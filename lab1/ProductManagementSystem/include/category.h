@@ -49,6 +49,25 @@ bool category_add_subgroup(Category* category, Subgroup subgroup);
  */
 bool category_remove_subgroup(Category* category, int subgroup_id);
 
+/**
+ * @brief Remove a subgroup from the category without freeing it
+ * @param category Pointer to category
+ * @param subgroup_id Subgroup ID to remove
+ * @param removed Receives the subgroup, which still owns its products
+ * @return true if successful, false otherwise
+ */
+bool category_detach_subgroup(Category* category, int subgroup_id, Subgroup* removed);
+
+/**
+ * @brief Shrink the subgroup array to the subgroup count
+ * @param category Pointer to category
+ * @return Bytes given back, 0 if the array was already tight
+ *
+ * Never shrinks below the initial capacity, so later adds keep doubling.
+ * The array may move: pointers to its subgroups become invalid.
+ */
+size_t category_shrink_to_fit(Category* category);
+
 /**
  * @brief Find a subgroup in the category by ID
  * @param category Pointer to category
@@ -0,0 +1,89 @@
+/**
+ * @file command.h
+ * @brief Non-interactive command mode for scripts and scheduled jobs
+ * @author PMS Team
+ * @date 2025
+ * @compatible Dev-C++ 6.3, TDM-GCC 9.2.0, C11
+ *
+ * Commands run directly against a DataStore with no menus, screen clears or
+ * pauses. Results are written one record per line with tab-separated
+ * fields; errors go to stderr. Arguments are separated by whitespace and may
+ * be double-quoted to contain spaces.
+ *
+ *   add-category <name> <description>                      -> new ID
+ *   add-subgroup <category_id> <name> <description>        -> new ID
+ *   add-product <subgroup_id> <code> <name> <description> <price> <quantity> -> new ID
+ *   update-product <id> code|name|description|price|quantity <value>
+ *   remove-category|remove-subgroup|remove-product <id>
+ *   find <product_id>                                      -> product row
+ *   find-code <code>                                       -> product row
+ *   search-name <text>                                     -> product rows
+ *   search-price <min> <max>                               -> product rows
+ *   search-quantity <min> <max>                            -> product rows
+ *   stats                                                  -> key/value rows
+ *   memory                                                 -> level, used, reserved, allocations
+ *   compact [renumber]                                     -> key/value rows
+ *   save [file]
+ *   metrics [text|json|on|off|reset]                      -> latency table (metrics.h)
+ *
+ * Setting PMS_METRICS=text or PMS_METRICS=json turns metrics on for the whole
+ * run and writes them to stderr on exit.
+ *
+ * Product rows are: id, subgroup_id, code, name, price, quantity.
+ *
+ * find is a hash lookup; find-code is not indexed and walks every product,
+ * so on large catalogs prefer find or search-name where possible.
+ */
+
+#ifndef COMMAND_H
+#define COMMAND_H
+
+#include <stdio.h>
+#include <stdbool.h>
+#include "utils.h"
+
+#define COMMAND_MAX_ARGS 16
+#define COMMAND_LINE_SIZE 1024
+
+typedef struct {
+    DataStore* store;
+    const char* data_file;     // Default target of "save"
+    FILE* out;                 // Results
+    int line;                  // Script line being run, 0 for command-line arguments
+} CommandContext;
+
+/**
+ * @brief Run one command given as separate arguments
+ * @param ctx Command context
+ * @param argc Number of arguments, argv[0] is the command name
+ * @param argv Arguments
+ * @return true if the command succeeded, false otherwise
+ */
+bool command_execute(CommandContext* ctx, int argc, char** argv);
+
+/**
+ * @brief Split a line into arguments and run it; blank lines and # comments succeed
+ * @param ctx Command context
+ * @param line Line to run, modified in place
+ * @return true if the command succeeded, false otherwise
+ */
+bool command_execute_line(CommandContext* ctx, char* line);
+
+/**
+ * @brief Run every line of a script, stopping at the first failure
+ * @param ctx Command context
+ * @param input Script stream
+ * @return true if every command succeeded, false otherwise
+ */
+bool command_run_script(CommandContext* ctx, FILE* input);
+
+/**
+ * @brief Entry point for command, script, server (--serve) and client (--connect) modes
+ * @param argc Argument count from main
+ * @param argv Arguments from main
+ * @param default_data_file Data file used without --data
+ * @return Process exit code, 0 on success
+ */
+int command_main(int argc, char** argv, const char* default_data_file);
+
+#endif // COMMAND_H
@@ -0,0 +1,159 @@
+/**
+ * @file handle.h
+ * @brief Generational handle tables for Product Management System
+ * @author PMS Team
+ * @date 2025
+ * @compatible Dev-C++ 6.3, TDM-GCC 9.2.0, C11
+ */
+
+#ifndef HANDLE_H
+#define HANDLE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#define HANDLE_INVALID_INDEX -1
+
+/**
+ * @brief Stable reference to an entity (slot index + generation)
+ *
+ * A handle stays valid across array reallocation and swap-and-pop moves.
+ * It becomes invalid (resolves to NULL) once the entity is removed, because
+ * the slot generation is bumped on release.
+ */
+typedef struct {
+    int index;
+    unsigned int generation;
+} CategoryHandle;
+
+typedef struct {
+    int index;
+    unsigned int generation;
+} SubgroupHandle;
+
+typedef struct {
+    int index;
+    unsigned int generation;
+} ProductHandle;
+
+/**
+ * @brief One slot of a handle table
+ *
+ * The location is stored relative to the parent: a product slot records its
+ * subgroup slot and its index in that subgroup's array, a subgroup slot its
+ * category slot, and a category slot only its index in the store. Moving one
+ * entity therefore only touches one slot.
+ */
+typedef struct {
+    unsigned int generation;
+    int id;                    // Entity ID, 0 when the slot is free
+    int parent_slot;           // Slot in the parent table, -1 for categories
+    int array_index;           // Index in the parent's dynamic array
+    int next_free;             // Free list link, -1 at the end
+} HandleSlot;
+
+/**
+ * @brief Entry of the ID -> slot map, id 0 when empty
+ */
+typedef struct {
+    int id;
+    int slot;
+} HandleIdEntry;
+
+/**
+ * @brief Slot table for one entity kind
+ *
+ * IDs are looked up in an open-addressing hash map, so memory follows the
+ * number of live entities and not the largest ID: a single product with
+ * ID 2^30 costs one map entry like any other.
+ */
+typedef struct {
+    HandleSlot* slots;         // Dynamic array
+    int slot_count;
+    int slot_capacity;         // Initial 16, double on resize
+    int free_head;             // First free slot, -1 if none
+
+    HandleIdEntry* id_map;     // Linear probing, at most half full
+    int id_map_capacity;       // Power of two, 0 until the first acquire
+    int id_map_count;
+} HandleTable;
+
+/**
+ * @brief Initialize an empty handle table
+ * @param table Pointer to handle table
+ */
+void handle_table_init(HandleTable* table);
+
+/**
+ * @brief Free handle table resources
+ * @param table Pointer to handle table
+ */
+void handle_table_free(HandleTable* table);
+
+/**
+ * @brief Release every slot, bumping all generations
+ * @param table Pointer to handle table
+ */
+void handle_table_clear(HandleTable* table);
+
+/**
+ * @brief Give back unused slot and ID map capacity
+ * @param table Pointer to handle table
+ * @return Bytes released
+ *
+ * Every slot is kept, free ones included, so their generations survive and
+ * handles from before a handle_table_clear stay invalid.
+ */
+size_t handle_table_shrink_to_fit(HandleTable* table);
+
+/**
+ * @brief Register an entity and return its slot
+ * @param table Pointer to handle table
+ * @param id Entity ID (must be > 0)
+ * @param parent_slot Slot of the parent entity (-1 for categories)
+ * @param array_index Index in the parent's array
+ * @return Slot index, or HANDLE_INVALID_INDEX on failure
+ */
+int handle_table_acquire(HandleTable* table, int id, int parent_slot, int array_index);
+
+/**
+ * @brief Grow the table so the next count acquires of new IDs cannot fail
+ * @param table Pointer to handle table
+ * @param count Number of entities about to be registered
+ * @return true if successful, false otherwise
+ */
+bool handle_table_reserve(HandleTable* table, int count);
+
+/**
+ * @brief Release the slot of an entity, invalidating its handles
+ * @param table Pointer to handle table
+ * @param id Entity ID
+ */
+void handle_table_release(HandleTable* table, int id);
+
+/**
+ * @brief Record that an entity moved to a new array index
+ * @param table Pointer to handle table
+ * @param id Entity ID
+ * @param array_index New index in the parent's array
+ */
+void handle_table_move(HandleTable* table, int id, int array_index);
+
+/**
+ * @brief Get the slot registered for an entity ID
+ * @param table Pointer to handle table
+ * @param id Entity ID
+ * @return Slot index, or HANDLE_INVALID_INDEX if not registered
+ */
+int handle_table_slot_of(const HandleTable* table, int id);
+
+/**
+ * @brief Validate a slot index / generation pair in O(1)
+ * @param table Pointer to handle table
+ * @param index Slot index
+ * @param generation Expected generation
+ * @return Pointer to the live slot, NULL if stale or out of range
+ */
+const HandleSlot* handle_table_lookup(const HandleTable* table, int index, unsigned int generation);
+
+#endif // HANDLE_H
@@ -0,0 +1,166 @@
+/**
+ * @file metrics.h
+ * @brief Per-operation call counters and latency histograms
+ * @author PMS Team
+ * @date 2025
+ * @compatible Dev-C++ 6.3, TDM-GCC 9.2.0, C11
+ *
+ * Every public mutation and query of the datastore, category, subgroup and
+ * product modules is timed between METRICS_START and METRICS_STOP. While
+ * collection is off (the default) that costs one relaxed atomic load per
+ * call; building with -DPMS_NO_METRICS removes it entirely.
+ *
+ * Latencies go into log-linear histograms: exact below 64 ns, then 32
+ * buckets per power of two (about 3% relative error) up to 2^40 ns.
+ * Recording is lock-free, so all threads share one set of histograms.
+ * Nested calls are counted at every level: datastore_add_product also
+ * records the subgroup_add_product it makes. Batches and transactions are
+ * timed per staged or logged call as well as at commit (and abort), so the
+ * cost of building one shows up next to the cost of applying it.
+ */
+
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+#define METRICS_SUB_BUCKET_BITS 5
+#define METRICS_MAX_EXPONENT 40    // Longer latencies are clamped to 2^40 ns (~18 minutes)
+#define METRICS_BUCKET_COUNT ((METRICS_MAX_EXPONENT - METRICS_SUB_BUCKET_BITS + 1) << METRICS_SUB_BUCKET_BITS)
+
+typedef enum {
+    METRIC_DATASTORE_ADD_CATEGORY,
+    METRIC_DATASTORE_ADD_SUBGROUP,
+    METRIC_DATASTORE_ADD_PRODUCT,
+    METRIC_DATASTORE_REMOVE_CATEGORY,
+    METRIC_DATASTORE_REMOVE_SUBGROUP,
+    METRIC_DATASTORE_REMOVE_PRODUCT,
+    METRIC_DATASTORE_UPDATE_PRODUCT,
+    METRIC_DATASTORE_FIND_CATEGORY,
+    METRIC_DATASTORE_FIND_SUBGROUP,
+    METRIC_DATASTORE_FIND_PRODUCT,
+    METRIC_DATASTORE_SEARCH_NAME,
+    METRIC_DATASTORE_SEARCH_PRICE,
+    METRIC_DATASTORE_SEARCH_QUANTITY,
+    METRIC_DATASTORE_STATISTICS,
+    METRIC_DATASTORE_BATCH_ADD,
+    METRIC_DATASTORE_BATCH_UPDATE,
+    METRIC_DATASTORE_BATCH_REMOVE,
+    METRIC_DATASTORE_BATCH_COMMIT,
+    METRIC_DATASTORE_TXN_ADD_CATEGORY,
+    METRIC_DATASTORE_TXN_REMOVE_CATEGORY,
+    METRIC_DATASTORE_TXN_ADD_SUBGROUP,
+    METRIC_DATASTORE_TXN_REMOVE_SUBGROUP,
+    METRIC_DATASTORE_TXN_ADD_PRODUCT,
+    METRIC_DATASTORE_TXN_REMOVE_PRODUCT,
+    METRIC_DATASTORE_TXN_UPDATE_PRODUCT,
+    METRIC_DATASTORE_TXN_MOVE_PRODUCT,
+    METRIC_DATASTORE_TXN_COMMIT,
+    METRIC_DATASTORE_TXN_ABORT,
+    METRIC_DATASTORE_MARK_MODIFIED,
+    METRIC_DATASTORE_COMPACT,
+    METRIC_DATASTORE_SAVE,
+    METRIC_DATASTORE_LOAD,
+    METRIC_CATEGORY_ADD_SUBGROUP,
+    METRIC_CATEGORY_REMOVE_SUBGROUP,
+    METRIC_CATEGORY_FIND_SUBGROUP,
+    METRIC_CATEGORY_UPDATE_NAME,
+    METRIC_CATEGORY_UPDATE_DESCRIPTION,
+    METRIC_SUBGROUP_ADD_PRODUCT,
+    METRIC_SUBGROUP_REMOVE_PRODUCT,
+    METRIC_SUBGROUP_FIND_PRODUCT,
+    METRIC_SUBGROUP_UPDATE_NAME,
+    METRIC_SUBGROUP_UPDATE_DESCRIPTION,
+    METRIC_PRODUCT_UPDATE_CODE,
+    METRIC_PRODUCT_UPDATE_NAME,
+    METRIC_PRODUCT_UPDATE_DESCRIPTION,
+    METRIC_PRODUCT_UPDATE_PRICE,
+    METRIC_PRODUCT_UPDATE_QUANTITY,
+    METRIC_COUNT
+} MetricId;
+
+typedef enum {
+    METRICS_TEXT,              // Aligned table, operations with no calls omitted
+    METRICS_JSON               // One JSON object, one operation per line
+} MetricsFormat;
+
+/**
+ * @brief Start time of a timed call, 0 when collection was off at the start
+ */
+typedef unsigned long long MetricTimer;
+
+typedef struct {
+    unsigned long long count;
+    unsigned long long failures;   // Calls that returned false or NULL
+    unsigned long long total_ns;
+    unsigned long long min_ns;
+    unsigned long long max_ns;
+    unsigned long long p50_ns;
+    unsigned long long p90_ns;
+    unsigned long long p99_ns;
+    unsigned long long p999_ns;
+} MetricSummary;
+
+extern atomic_bool metrics_active;
+
+#ifdef PMS_NO_METRICS
+#define METRICS_START() ((MetricTimer)0)
+#define METRICS_STOP(id, timer, ok) ((void)(id), (void)(timer), (void)(ok))
+#else
+#define METRICS_START() \
+    (atomic_load_explicit(&metrics_active, memory_order_relaxed) ? metrics_now_ns() : (MetricTimer)0)
+#define METRICS_STOP(id, timer, ok) \
+    do { if (timer) metrics_record((id), metrics_now_ns() - (timer), (ok)); } while (0)
+#endif
+
+/**
+ * @brief Turn collection on or off; recorded data is kept
+ */
+void metrics_set_enabled(bool enabled);
+
+bool metrics_enabled(void);
+
+/**
+ * @brief Clear every counter and histogram
+ *
+ * Calls recorded concurrently with a reset may be partly kept.
+ */
+void metrics_reset(void);
+
+/**
+ * @brief Monotonic clock in nanoseconds, never 0
+ */
+unsigned long long metrics_now_ns(void);
+
+/**
+ * @brief Add one call to an operation's counters and histogram
+ * @param id Operation
+ * @param elapsed_ns Call latency
+ * @param ok false if the call failed
+ */
+void metrics_record(MetricId id, unsigned long long elapsed_ns, bool ok);
+
+/**
+ * @brief Function name an operation is reported under
+ */
+const char* metrics_name(MetricId id);
+
+/**
+ * @brief Counters and percentiles of one operation
+ *
+ * Percentiles are the upper bound of the histogram bucket they fall in,
+ * capped at the largest recorded value.
+ */
+MetricSummary metrics_summary(MetricId id);
+
+/**
+ * @brief Write every operation's summary
+ * @param out Output stream
+ * @param format METRICS_TEXT or METRICS_JSON
+ * @return Number of lines written
+ */
+int metrics_dump(FILE* out, MetricsFormat format);
+
+#endif // METRICS_H
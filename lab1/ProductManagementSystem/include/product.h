@@ -11,6 +11,8 @@
 
 #include <stdbool.h>
 
+#define PRODUCT_NAME_SIZE 100
+
 /**
  * @brief Product structure
  */
@@ -18,7 +20,7 @@ typedef struct {
     int id;
     int subgroup_id;
     char code[20];
-    char name[100];
+    char name[PRODUCT_NAME_SIZE];
     char description[200];
     float price;
     int quantity;
@@ -102,6 +104,13 @@ bool product_update_price(Product* product, float price);
  */
 bool product_update_quantity(Product* product, int quantity);
 
+/**
+ * @brief ASCII-lowercase copy of a product name, as searched by name
+ * @param name Product name
+ * @param folded Output, PRODUCT_NAME_SIZE bytes; the tail after the name is zeroed
+ */
+void product_fold_name(const char* name, char* folded);
+
 /**
  * @brief Update product timestamp
  * @param product Pointer to product
@@ -0,0 +1,93 @@
+/**
+ * @file product_table.h
+ * @brief Column table of product scan fields for whole-catalog scans
+ * @author PMS Team
+ * @date 2025
+ * @compatible Dev-C++ 6.3, TDM-GCC 9.2.0, C11
+ */
+
+#ifndef PRODUCT_TABLE_H
+#define PRODUCT_TABLE_H
+
+#include "category.h"
+#include "handle.h"
+#include <stdbool.h>
+
+/**
+ * @brief The fields every full scan reads, one dense column per field
+ *
+ * The table holds no Product copies: each row names the product handle
+ * slot it was written from, and matches are resolved through the handle
+ * table. Price and quantity columns let range filters read only the bytes
+ * they test; the same goes for the case-folded names used by name search.
+ *
+ * Rows are in no particular order; searches put their matches back into
+ * hierarchy order through the handle table. Once built, the table is
+ * patched row by row as products are added (append), removed (swap-and-pop)
+ * or updated, so a mutation costs O(1) here instead of a rebuild on the
+ * next scan. Only changes the store cannot see one by one
+ * (datastore_mark_modified, handle rebuilds) drop it for a full rebuild.
+ */
+typedef struct {
+    int* slots;                // Product handle slot of each row
+    float* prices;             // Copies of Product.price / .quantity
+    int* quantities;           // for the vectorized range filters
+    char* names_folded;        // PRODUCT_NAME_SIZE bytes per row, see product_fold_name
+    int product_count;         // Rows in use
+    int product_capacity;      // Rows allocated in every column
+
+    int* row_of_slot;          // Row of each product handle slot, -1 for none
+    int slot_capacity;
+
+    bool is_built;             // false until rebuilt; patches are skipped meanwhile
+} ProductTable;
+
+/**
+ * @brief Initialize an empty product table
+ * @param table Pointer to product table
+ */
+void product_table_init(ProductTable* table);
+
+/**
+ * @brief Free product table resources
+ * @param table Pointer to product table
+ */
+void product_table_free(ProductTable* table);
+
+/**
+ * @brief Rebuild the table from the category hierarchy
+ * @param table Pointer to product table
+ * @param handles Product handle table every product is registered in
+ * @param categories Category array
+ * @param category_count Number of categories
+ * @return true if successful, false otherwise
+ */
+bool product_table_rebuild(ProductTable* table, const HandleTable* handles,
+                           const Category* categories, int category_count);
+
+/**
+ * @brief Append the row of a newly registered product
+ * @param table Pointer to product table
+ * @param slot Product handle slot
+ * @param product Product registered in that slot
+ * @return true if successful or the table is not built; on failure the
+ *         table is dropped and rebuilt by the next scan
+ */
+bool product_table_insert(ProductTable* table, int slot, const Product* product);
+
+/**
+ * @brief Rewrite the row of a product after its fields changed
+ * @param table Pointer to product table
+ * @param slot Product handle slot
+ * @param product Current product data
+ */
+void product_table_update(ProductTable* table, int slot, const Product* product);
+
+/**
+ * @brief Drop the row of a product, moving the last row into its place
+ * @param table Pointer to product table
+ * @param slot Product handle slot
+ */
+void product_table_remove(ProductTable* table, int slot);
+
+#endif // PRODUCT_TABLE_H
@@ -0,0 +1,85 @@
+/**
+ * @file render.h
+ * @brief Buffered console output and screen control
+ * @author PMS Team
+ * @date 2025
+ * @compatible Dev-C++ 6.3, TDM-GCC 9.2.0, C11
+ *
+ * Between render_begin and render_end, everything written through
+ * render_printf, render_write and set_color is collected in one large
+ * buffer and handed to the console in a few big writes instead of one
+ * (or, on Windows, several) per row. Outside a render block the same
+ * functions write straight to stdout, so the *_display functions can be
+ * used either way.
+ *
+ * Nothing may be written to stdout with printf inside a render block: it
+ * would come out ahead of the buffered text. The buffer is process-wide
+ * and belongs to the UI thread.
+ *
+ * Screen clearing happens in process: ANSI sequences where the terminal
+ * understands them, console API calls on older Windows consoles. It does
+ * not spawn a shell.
+ */
+
+#ifndef RENDER_H
+#define RENDER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#define RENDER_BUFFER_SIZE (256 * 1024)
+
+#if defined(__GNUC__)
+#define RENDER_PRINTF_FORMAT __attribute__((format(printf, 1, 2)))
+#else
+#define RENDER_PRINTF_FORMAT
+#endif
+
+/**
+ * @brief Start buffering output; blocks may nest
+ */
+void render_begin(void);
+
+/**
+ * @brief End a render block, writing out the buffer when the outermost one ends
+ */
+void render_end(void);
+
+/**
+ * @brief Check whether output is currently being buffered
+ */
+bool render_active(void);
+
+/**
+ * @brief Formatted output, buffered inside a render block
+ * @return Number of characters written, negative on a formatting error
+ */
+int render_printf(const char* format, ...) RENDER_PRINTF_FORMAT;
+
+/**
+ * @brief Unformatted output, buffered inside a render block
+ */
+void render_write(const char* text, size_t length);
+
+/**
+ * @brief Write out whatever is buffered so far
+ */
+void render_flush(void);
+
+/**
+ * @brief Check whether the console interprets ANSI escape sequences
+ *
+ * Always true outside Windows. On Windows 10 and later this switches the
+ * console into virtual terminal mode on first use; older consoles and
+ * redirected output report false.
+ */
+bool render_ansi_supported(void);
+
+/**
+ * @brief Clear the screen and its scrollback, leaving the cursor top left
+ *
+ * Does nothing on Windows when stdout is not a console.
+ */
+void render_clear_screen(void);
+
+#endif // RENDER_H
@@ -0,0 +1,53 @@
+/**
+ * @file server.h
+ * @brief Socket query server and client for one shared in-memory catalog
+ * @author PMS Team
+ * @date 2025
+ * @compatible Dev-C++ 6.3, TDM-GCC 9.2.0, C11
+ *
+ * Requests are command lines in the command.h syntax, one per '\n'.
+ * Each request gets one response, in request order:
+ *
+ *   OK <n>\n  followed by n result lines
+ *   ERR\n     the command failed (details are logged by the server)
+ *
+ * Clients may pipeline: send any number of requests before reading.
+ * The server is a single-threaded epoll loop, so requests from all
+ * clients are applied one at a time against the same DataStore.
+ * Addresses are either a TCP port on 127.0.0.1 or a Unix socket path
+ * (anything containing '/').
+ *
+ * Requires Linux; elsewhere both functions report an error.
+ */
+
+#ifndef SERVER_H
+#define SERVER_H
+
+#include <stdio.h>
+#include <stdbool.h>
+#include "utils.h"
+
+#define SERVER_MAX_EVENTS 64
+#define SERVER_READ_CHUNK 65536
+
+/**
+ * @brief Serve a store until SIGINT or SIGTERM
+ * @param store Store to serve; it is not saved on exit unless a client sends "save"
+ * @param address TCP port or Unix socket path
+ * @param data_file Default target of "save"
+ * @return true on a clean shutdown, false if the server could not start
+ */
+bool server_run(DataStore* store, const char* address, const char* data_file);
+
+/**
+ * @brief Send every line of a script to a server and print the responses
+ * @param address TCP port or Unix socket path
+ * @param input Request lines
+ * @return true if every request succeeded, false otherwise
+ *
+ * Requests are written while responses are read, so scripts of any size
+ * are pipelined without waiting for each reply.
+ */
+bool client_run(const char* address, FILE* input);
+
+#endif // SERVER_H
@@ -0,0 +1,104 @@
+/**
+ * @file sharded_store.h
+ * @brief Catalog partitioned by category across independent DataStore shards
+ * @author PMS Team
+ * @date 2025
+ * @compatible Dev-C++ 6.3, TDM-GCC 9.2.0, C11
+ *
+ * Each shard is a full DataStore with its own lock, handles, scan table and
+ * data file, so writers on different shards never contend. IDs encode their
+ * shard: shard i hands out i + 1, i + 1 + N, i + 1 + 2N, ... for all three
+ * entity kinds, and a subgroup or product always lives in the shard of its
+ * parent, so every ID routes with one modulo and no shared map.
+ */
+
+#ifndef SHARDED_STORE_H
+#define SHARDED_STORE_H
+
+#include "utils.h"
+
+#define SHARDED_STORE_MAX_SHARDS 64
+
+typedef struct {
+    DataStore* shards;
+    int shard_count;
+    atomic_uint next_shard;    // Round-robin placement of new categories
+    ThreadPool* pool;          // Fans queries out across shards, NULL for serial
+} ShardedStore;
+
+/**
+ * @brief Create shard_count empty shards with concurrency enabled
+ * @param store Store to initialize
+ * @param shard_count Number of shards (1..SHARDED_STORE_MAX_SHARDS)
+ * @param thread_count Fan-out threads including the caller, 0 for one per CPU, 1 for serial
+ * @return true if successful, false otherwise
+ */
+bool sharded_store_init(ShardedStore* store, int shard_count, int thread_count);
+
+/**
+ * @brief Free all shards and the fan-out pool
+ * @param store Pointer to store
+ */
+void sharded_store_free(ShardedStore* store);
+
+/**
+ * @brief Shard that owns an ID of any kind
+ * @return Shard index, -1 for an invalid ID
+ */
+int sharded_store_shard_of(const ShardedStore* store, int id);
+
+/**
+ * @brief DataStore that owns an ID; lock it for find/resolve as with any DataStore
+ * @return Shard, NULL for an invalid ID
+ */
+DataStore* sharded_store_shard_for(ShardedStore* store, int id);
+
+/**
+ * @brief Add a category to the next shard in turn
+ * @return New category ID, 0 on failure
+ */
+int sharded_store_add_category(ShardedStore* store, const char* name, const char* description);
+
+/**
+ * @brief Add a subgroup to the shard of its category
+ * @return New subgroup ID, 0 on failure
+ */
+int sharded_store_add_subgroup(ShardedStore* store, int category_id,
+                               const char* name, const char* description);
+
+/**
+ * @brief Add a product to the shard of its subgroup
+ * @param product Product data; id and subgroup_id are assigned here
+ * @return New product ID, 0 on failure
+ */
+int sharded_store_add_product(ShardedStore* store, int subgroup_id, Product product);
+
+bool sharded_store_remove_category(ShardedStore* store, int category_id);
+bool sharded_store_remove_subgroup(ShardedStore* store, int subgroup_id);
+bool sharded_store_remove_product(ShardedStore* store, int product_id);
+
+/**
+ * @brief Search every shard and merge the results in shard order
+ */
+SearchResult sharded_store_search_by_name(ShardedStore* store, const char* name);
+SearchResult sharded_store_search_by_price(ShardedStore* store, float min_price, float max_price);
+SearchResult sharded_store_search_by_quantity(ShardedStore* store, int min_qty, int max_qty);
+
+/**
+ * @brief Statistics over all shards
+ */
+Statistics sharded_store_get_statistics(ShardedStore* store);
+
+/**
+ * @brief Save each shard to "<base_path>.shard<i>.dat"
+ * @return true if every shard was saved, false otherwise
+ */
+bool sharded_store_save(ShardedStore* store, const char* base_path);
+
+/**
+ * @brief Load each shard from "<base_path>.shard<i>.dat" (missing files load empty)
+ * @return true if every shard loaded and its IDs route back to it, false otherwise
+ */
+bool sharded_store_load(ShardedStore* store, const char* base_path);
+
+#endif // SHARDED_STORE_H
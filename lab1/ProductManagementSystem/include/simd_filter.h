@@ -0,0 +1,77 @@
+/**
+ * @file simd_filter.h
+ * @brief Vectorized range filter kernels over price/quantity columns
+ * @author PMS Team
+ * @date 2025
+ * @compatible Dev-C++ 6.3, TDM-GCC 9.2.0, C11
+ */
+
+#ifndef SIMD_FILTER_H
+#define SIMD_FILTER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief Number of 64-bit words needed for a match bitmap of count rows
+ */
+#define FILTER_BITMAP_WORDS(count) (((count) + 63) / 64)
+
+/**
+ * @brief Mark rows with min_price <= price <= max_price
+ * @param prices Price column
+ * @param count Number of rows
+ * @param min_price Lower bound (inclusive)
+ * @param max_price Upper bound (inclusive)
+ * @param bitmap Output, FILTER_BITMAP_WORDS(count) words; bit i set on match
+ * @return Number of matching rows
+ *
+ * Uses AVX2 or SSE2 when the CPU supports it, scalar code otherwise.
+ */
+int filter_price_range(const float* prices, int count, float min_price, float max_price, uint64_t* bitmap);
+
+/**
+ * @brief Mark rows with min_qty <= quantity <= max_qty
+ * @param quantities Quantity column
+ * @param count Number of rows
+ * @param min_qty Lower bound (inclusive)
+ * @param max_qty Upper bound (inclusive)
+ * @param bitmap Output, FILTER_BITMAP_WORDS(count) words; bit i set on match
+ * @return Number of matching rows
+ */
+int filter_quantity_range(const int* quantities, int count, int min_qty, int max_qty, uint64_t* bitmap);
+
+/**
+ * @brief Mark rows whose text field contains needle, ignoring ASCII case
+ * @param first_field Address of the field in row 0 (e.g. products[0].name)
+ * @param stride Distance in bytes between rows (e.g. sizeof(Product))
+ * @param field_size Size of the fixed char array; every byte must be readable
+ * @param count Number of rows
+ * @param needle Lowercase pattern
+ * @param needle_len Length of needle
+ * @param bitmap Output, FILTER_BITMAP_WORDS(count) words; bit i set on match
+ * @return Number of matching rows
+ *
+ * Compares the first and last needle characters against 16/32-byte blocks
+ * of the case-folded field and only verifies the middle on candidates, so
+ * no lowercase copy of the field is made.
+ */
+int filter_text_contains(const char* first_field, size_t stride, size_t field_size, int count,
+                         const char* needle, size_t needle_len, uint64_t* bitmap);
+
+/**
+ * @brief Name of the kernel selected for this CPU ("avx2", "sse2" or "scalar")
+ */
+const char* filter_kernel_name(void);
+
+/**
+ * @brief Use one kernel instead of the best one for this CPU, for tests and benchmarks
+ * @param name "avx2", "sse2" or "scalar"; NULL goes back to automatic selection
+ * @return false if the name is unknown or the CPU lacks that kernel (nothing changes)
+ *
+ * Not synchronized: call it while no filter is running.
+ */
+bool filter_force_kernel(const char* name);
+
+#endif // SIMD_FILTER_H
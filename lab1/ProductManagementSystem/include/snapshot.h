@@ -0,0 +1,193 @@
+/**
+ * @file snapshot.h
+ * @brief Immutable multi-version views of the catalog with epoch-based reclamation
+ * @author PMS Team
+ * @date 2025
+ * @compatible Dev-C++ 6.3, TDM-GCC 9.2.0, C11
+ *
+ * A Snapshot is a read-only copy of the category/subgroup/product hierarchy
+ * built from the same Category, Subgroup and Product types as the store.
+ * Each publish copies only the categories array plus the subgroup and
+ * product arrays that changed; unchanged arrays are shared with the previous
+ * version. Readers pin an epoch and never take a lock; replaced arrays are
+ * freed once every reader that could still see them has unpinned.
+ */
+
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include "category.h"
+
+#define SNAPSHOT_MAX_READERS 64    // Concurrently pinned readers
+
+/**
+ * @brief Immutable product array of one subgroup
+ */
+typedef struct {
+    unsigned long stamp;       // Last publish that used this block (writer only)
+    int owner_id;              // Subgroup ID
+    int count;
+    Product items[];
+} ProductBlock;
+
+/**
+ * @brief Immutable subgroup array of one category
+ */
+typedef struct {
+    unsigned long stamp;       // Last publish that used this block (writer only)
+    int owner_id;              // Category ID
+    int count;
+    int product_total;         // Products in all subgroups of the block
+    Subgroup items[];          // products point into ProductBlocks
+} SubgroupBlock;
+
+/**
+ * @brief Store-level fields captured with each snapshot
+ */
+typedef struct {
+    unsigned long version;     // DataStore version the snapshot was taken at
+    int next_category_id;
+    int next_subgroup_id;
+    int next_product_id;
+    bool is_modified;
+    char last_saved[20];
+} SnapshotInfo;
+
+/**
+ * @brief One published version of the catalog; never modified after publish
+ */
+typedef struct {
+    SnapshotInfo info;
+    int product_count;
+    int category_count;
+    Category categories[];     // subgroups point into SubgroupBlocks
+} Snapshot;
+
+typedef struct {
+    void* block;
+    unsigned long epoch;       // Global epoch when the block was unlinked
+} RetiredBlock;
+
+/**
+ * @brief Entry of a block map, id 0 when empty
+ */
+typedef struct {
+    int id;
+    void* block;
+} BlockMapEntry;
+
+/**
+ * @brief Open-addressing map from entity ID to its cached block
+ *
+ * Sized by the number of cached blocks, not the largest ID, like the
+ * handle tables' ID maps.
+ */
+typedef struct {
+    BlockMapEntry* entries;    // Linear probing, at most half full
+    int capacity;              // Power of two, 0 until the first insert
+    int count;
+} BlockMap;
+
+/**
+ * @brief Published snapshot plus the reclamation state
+ *
+ * Pin/unpin may run on any thread at any time. Everything else is writer
+ * side and must be serialized by the caller (the store's write lock).
+ */
+typedef struct {
+    _Atomic(Snapshot*) current;
+    atomic_ulong epoch;
+    atomic_ulong reader_epochs[SNAPSHOT_MAX_READERS];   // 0 = slot free
+
+    unsigned long stamp;       // Publish counter
+    bool verify;               // Reuse product blocks only if their content still matches
+
+    BlockMap category_blocks;  // SubgroupBlock* by category ID, reuse candidates
+    BlockMap subgroup_blocks;  // ProductBlock* by subgroup ID, reuse candidates
+
+    RetiredBlock* retired;
+    int retired_count;
+    int retired_capacity;
+
+    void** fresh;              // Blocks allocated by the publish in progress
+    int fresh_count;
+    int fresh_capacity;
+} SnapshotDomain;
+
+/**
+ * @brief A reader's hold on one snapshot
+ */
+typedef struct {
+    const Snapshot* snapshot;
+    int slot;
+} SnapshotPin;
+
+/**
+ * @brief Initialize an empty domain (no snapshot published yet)
+ * @param domain Pointer to domain
+ */
+void snapshot_domain_init(SnapshotDomain* domain);
+
+/**
+ * @brief Free the current snapshot and everything retired
+ * @param domain Pointer to domain, no reader may be pinned
+ */
+void snapshot_domain_free(SnapshotDomain* domain);
+
+/**
+ * @brief Drop the shared arrays of a changed category and/or subgroup
+ * @param domain Pointer to domain
+ * @param category_id Category whose subgroup array changed, 0 for none
+ * @param subgroup_id Subgroup whose product array changed, 0 for none
+ */
+void snapshot_invalidate(SnapshotDomain* domain, int category_id, int subgroup_id);
+
+/**
+ * @brief Rebuild every subgroup array on the next publish and compare product arrays
+ *
+ * For changes made in place where the caller does not know what changed.
+ */
+void snapshot_invalidate_all(SnapshotDomain* domain);
+
+/**
+ * @brief Publish a new snapshot of the hierarchy and reclaim what readers released
+ * @param domain Pointer to domain
+ * @param info Store-level fields to capture
+ * @param categories Live category array
+ * @param category_count Number of categories
+ * @return true if successful, false otherwise (the previous snapshot stays current)
+ */
+bool snapshot_publish(SnapshotDomain* domain, const SnapshotInfo* info,
+                      const Category* categories, int category_count);
+
+/**
+ * @brief Bytes held by the current snapshot and the domain's bookkeeping
+ * @param domain Pointer to domain
+ * @param used Receives the size of the current snapshot and its blocks
+ * @param reserved Receives used plus the reuse maps and reclamation lists
+ * @param allocations Receives the number of heap blocks counted
+ *
+ * Blocks waiting for reclamation are not counted. Writer side: no publish
+ * may run concurrently.
+ */
+void snapshot_domain_memory(const SnapshotDomain* domain, size_t* used, size_t* reserved,
+                            long long* allocations);
+
+/**
+ * @brief Pin the current snapshot; lock-free and never waits for writers
+ * @param domain Pointer to domain
+ * @param pin Output pin, pin->snapshot is NULL if nothing was published yet
+ * @return true if successful, false if all reader slots are in use
+ */
+bool snapshot_pin(SnapshotDomain* domain, SnapshotPin* pin);
+
+/**
+ * @brief Release a pinned snapshot
+ * @param domain Pointer to domain
+ * @param pin Pin returned by snapshot_pin
+ */
+void snapshot_unpin(SnapshotDomain* domain, SnapshotPin* pin);
+
+#endif // SNAPSHOT_H
@@ -11,6 +11,7 @@
 
 #include "product.h"
 #include <stdbool.h>
+#include <stddef.h>
 /**
  * @brief Display subgroup table footer
  */
@@ -46,6 +47,24 @@ Subgroup subgroup_create(int id, int category_id, const char* name, const char*
  */
 bool subgroup_add_product(Subgroup* subgroup, Product product);
 
+/**
+ * @brief Grow the product array so it holds at least capacity products
+ * @param subgroup Pointer to subgroup
+ * @param capacity Required capacity
+ * @return true if successful, false otherwise
+ */
+bool subgroup_reserve(Subgroup* subgroup, int capacity);
+
+/**
+ * @brief Shrink the product array to the product count
+ * @param subgroup Pointer to subgroup
+ * @return Bytes given back, 0 if the array was already tight
+ *
+ * Never shrinks below the initial capacity, so later adds keep doubling.
+ * The array may move: pointers to its products become invalid.
+ */
+size_t subgroup_shrink_to_fit(Subgroup* subgroup);
+
 /**
  * @brief Remove a product from the subgroup by ID
  * @param subgroup Pointer to subgroup
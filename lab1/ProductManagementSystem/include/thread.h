@@ -0,0 +1,91 @@
+/**
+ * @file thread.h
+ * @brief Portable threads, mutexes, condition variables and RW locks
+ * @author PMS Team
+ * @date 2025
+ * @compatible Dev-C++ 6.3, TDM-GCC 9.2.0, C11
+ *
+ * Windows API on Windows (Vista or later), POSIX threads elsewhere. POSIX
+ * builds with -std=c11 need -D_POSIX_C_SOURCE=200809L for pthread_rwlock_t.
+ * None of the primitives may be copied after *_init.
+ */
+
+#ifndef THREAD_H
+#define THREAD_H
+
+#include <stdbool.h>
+
+#ifdef _WIN32
+#ifndef _WIN32_WINNT
+#define _WIN32_WINNT 0x0600    // SRWLOCK / CONDITION_VARIABLE
+#endif
+#include <windows.h>
+
+typedef HANDLE Thread;
+typedef CRITICAL_SECTION Mutex;
+typedef CONDITION_VARIABLE CondVar;
+typedef SRWLOCK RwLock;
+#else
+#include <pthread.h>
+
+typedef pthread_t Thread;
+typedef pthread_mutex_t Mutex;
+typedef pthread_cond_t CondVar;
+
+/**
+ * @brief Writer-preferring RW lock
+ *
+ * Default pthread RW locks let new readers in while a writer waits, so a
+ * steady stream of overlapping readers can keep it out forever. Every
+ * acquirer passes the turnstile first and a writer holds it until it has
+ * the lock, so readers arriving after a waiting writer queue behind it.
+ * SRW locks on Windows already behave this way.
+ */
+typedef struct {
+    pthread_rwlock_t lock;
+    pthread_mutex_t turnstile;
+} RwLock;
+#endif
+
+typedef void (*ThreadFunc)(void* arg);
+
+/**
+ * @brief Start a thread running func(arg)
+ * @param thread Output thread handle
+ * @param func Thread entry point
+ * @param arg Argument passed to func
+ * @return true if successful, false otherwise
+ */
+bool thread_create(Thread* thread, ThreadFunc func, void* arg);
+
+/**
+ * @brief Wait for a thread to finish and release it
+ * @param thread Thread handle
+ */
+void thread_join(Thread thread);
+
+/**
+ * @brief Number of online logical CPUs (at least 1)
+ */
+int thread_cpu_count(void);
+
+void mutex_init(Mutex* mutex);
+void mutex_destroy(Mutex* mutex);
+void mutex_lock(Mutex* mutex);
+void mutex_unlock(Mutex* mutex);
+bool mutex_trylock(Mutex* mutex);    // true if the lock was taken
+
+void cond_init(CondVar* cond);
+void cond_destroy(CondVar* cond);
+void cond_wait(CondVar* cond, Mutex* mutex);
+void cond_signal(CondVar* cond);
+void cond_broadcast(CondVar* cond);
+
+void rwlock_init(RwLock* lock);
+void rwlock_destroy(RwLock* lock);
+void rwlock_read_lock(RwLock* lock);
+void rwlock_read_unlock(RwLock* lock);
+void rwlock_write_lock(RwLock* lock);
+void rwlock_write_unlock(RwLock* lock);
+
+#endif // THREAD_H
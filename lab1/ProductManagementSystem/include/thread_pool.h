@@ -0,0 +1,73 @@
+/**
+ * @file thread_pool.h
+ * @brief Fixed-size worker pool running parallel-for jobs
+ * @author PMS Team
+ * @date 2025
+ * @compatible Dev-C++ 6.3, TDM-GCC 9.2.0, C11
+ */
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include "thread.h"
+#include <stdbool.h>
+
+/**
+ * @brief One unit of a parallel job
+ * @param context Job context passed to thread_pool_run
+ * @param task_index Task number in [0, task_count)
+ */
+typedef void (*ThreadTask)(void* context, int task_index);
+
+/**
+ * @brief Worker pool; the calling thread also runs tasks while it waits
+ */
+typedef struct {
+    Thread* threads;           // Worker threads (thread_count - 1 of them)
+    int thread_count;          // Including the calling thread
+
+    Mutex lock;
+    CondVar work_ready;
+    CondVar work_done;
+    Mutex run_lock;            // Held by the thread currently running a job
+
+    ThreadTask task;
+    void* context;
+    int task_count;
+    int next_task;
+    int pending_tasks;
+    unsigned long job_generation;
+    bool stopping;
+} ThreadPool;
+
+/**
+ * @brief Create a pool
+ * @param thread_count Total threads including the caller, 0 for one per CPU
+ * @return Pointer to pool, NULL on failure
+ */
+ThreadPool* thread_pool_create(int thread_count);
+
+/**
+ * @brief Stop the workers and free the pool
+ * @param pool Pointer to pool (may be NULL)
+ */
+void thread_pool_destroy(ThreadPool* pool);
+
+/**
+ * @brief Run task(context, i) for every i in [0, task_count) and wait
+ * @param pool Pointer to pool, NULL runs all tasks on the calling thread
+ *
+ * If another thread is already running a job on the pool, the tasks run
+ * on the calling thread so concurrent callers never wait for each other.
+ * @param task Task function
+ * @param context Job context
+ * @param task_count Number of tasks
+ */
+void thread_pool_run(ThreadPool* pool, ThreadTask task, void* context, int task_count);
+
+/**
+ * @brief Number of threads that run tasks (1 for a NULL pool)
+ */
+int thread_pool_size(const ThreadPool* pool);
+
+#endif // THREAD_POOL_H
@@ -0,0 +1,32 @@
+/**
+ * @file timestamp.h
+ * @brief Cached wall-clock timestamps
+ * @author PMS Team
+ * @date 2025
+ * @compatible Dev-C++ 6.3, TDM-GCC 9.2.0, C11
+ *
+ * Every product edit stamps updated_at, so formatting the local time has to
+ * be cheap. Each thread keeps the last second it formatted and only calls
+ * into the C library's time conversion when the second changes; within a
+ * second a timestamp is a clock read and a 20-byte copy. The cache is per
+ * thread and the conversion uses the reentrant localtime_r (localtime_s on
+ * Windows), so no locking is needed.
+ */
+
+#ifndef TIMESTAMP_H
+#define TIMESTAMP_H
+
+#include <stddef.h>
+
+#define TIMESTAMP_SIZE 20          // "YYYY-MM-DD HH:MM:SS" and the terminator
+
+/**
+ * @brief Current local time as "YYYY-MM-DD HH:MM:SS"
+ * @param buffer Output buffer
+ * @param size Buffer size, at least TIMESTAMP_SIZE; smaller buffers are left untouched
+ *
+ * Writes an empty string if the clock cannot be converted to local time.
+ */
+void timestamp_now(char* buffer, size_t size);
+
+#endif // TIMESTAMP_H
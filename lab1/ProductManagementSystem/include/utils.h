@@ -10,8 +10,14 @@
 #define UTILS_H
 
 #include <stddef.h>
+#include <stdio.h>
 #include <stdbool.h>
+#include <stdatomic.h>
 #include "category.h"
+#include "handle.h"
+#include "product_table.h"
+#include "thread_pool.h"
+#include "snapshot.h"
 
 // ============================================================================
 // Color codes for Windows console
@@ -33,21 +39,55 @@ typedef enum {
  */
 void set_color(ConsoleColor color);
 
+/**
+ * @brief Set the text color of the stream a message is written to
+ * @param stream stdout or stderr; stdout behaves exactly like set_color
+ * @param color Color code from ConsoleColor enum
+ *
+ * Use this around fprintf(stderr, ...): set_color goes to stdout, so its
+ * escape codes would land in the wrong stream and out of order.
+ */
+void set_stream_color(FILE* stream, ConsoleColor color);
+
 // ============================================================================
 // Core types
 // ============================================================================
 
+/**
+ * @brief Locks shared by every thread using one DataStore
+ */
+typedef struct {
+    RwLock rwlock;             // Shared: lookups, scans, reports; exclusive: mutations
+    Mutex scan_lock;           // Guards the scan table between readers (lazy rebuilds, memory report)
+    Mutex save_lock;           // Serializes snapshot saves, which run without rwlock
+} DataStoreLock;
+
+typedef struct DataStoreTxn DataStoreTxn;
+
 typedef struct {
     Category* categories;
     int category_count;
     int category_capacity;     // Initial 10, double on resize
     
-    int next_category_id;      // Start from 1
-    int next_subgroup_id;
-    int next_product_id;
+    atomic_int next_category_id;   // Start from 1, see datastore_allocate_id
+    atomic_int next_subgroup_id;
+    atomic_int next_product_id;
     
     bool is_modified;
     char last_saved[20];
+    unsigned long version;     // Bumped on every modification
+    
+    HandleTable category_handles;  // Stable references, see handle.h
+    HandleTable subgroup_handles;
+    HandleTable product_handles;
+    
+    ProductTable scan_table;   // Scan columns, patched by mutations, see product_table.h
+    ThreadPool* pool;          // Scan workers, NULL for single-threaded
+    DataStoreLock* lock;       // NULL until datastore_enable_concurrency
+    SnapshotDomain* snapshots; // NULL until datastore_enable_snapshots
+    DataStoreTxn* txn;         // Open transaction, NULL outside one
+    bool quiet;                // Skip load/save progress messages; errors still go to stderr
+    bool ids_striped;          // Shard of a ShardedStore: IDs follow its stripe, see sharded_store.h
 } DataStore;
 
 typedef struct {
@@ -59,17 +99,143 @@ typedef struct {
     int total_quantity;
 } Statistics;
 
+/**
+ * @brief Bytes in use vs. allocated for one part of a store
+ */
+typedef struct {
+    size_t used;               // Bytes holding live entries
+    size_t reserved;           // Bytes allocated; reserved - used is growth slack
+    long long allocations;     // Number of separate heap blocks
+} MemoryUsage;
+
+/**
+ * @brief Memory held by a store, level by level
+ *
+ * strings breaks down the fixed-size text fields that are already counted
+ * in categories, subgroups and products: used is the characters actually
+ * stored (with terminators), reserved the size of the fields. It is not
+ * part of total.
+ */
+typedef struct {
+    MemoryUsage categories;    // DataStore.categories
+    MemoryUsage subgroups;     // Every Category.subgroups array
+    MemoryUsage products;      // Every Subgroup.products array
+    MemoryUsage handles;       // Slot arrays and ID maps of the three handle tables
+    MemoryUsage scan_table;    // Scan columns and the slot -> row index
+    MemoryUsage snapshots;     // Current snapshot and its bookkeeping, if enabled
+    MemoryUsage strings;       // Code, name and description fields (see above)
+    MemoryUsage total;         // Sum of every level except strings
+} MemoryReport;
+
 typedef struct {
     Product* products;
     int count;
 } SearchResult;
 
+typedef enum {
+    ID_CATEGORY,
+    ID_SUBGROUP,
+    ID_PRODUCT
+} IdKind;
+
+typedef enum {
+    BATCH_ADD,
+    BATCH_UPDATE,
+    BATCH_REMOVE
+} BatchOpKind;
+
+typedef struct {
+    BatchOpKind kind;
+    int subgroup_id;           // Target subgroup (BATCH_ADD only)
+    Product product;           // Full record for add/update, only id for remove
+} BatchOp;
+
+/**
+ * @brief Product mutations buffered without touching the store until commit
+ */
+typedef struct {
+    DataStore* store;
+    BatchOp* ops;
+    int op_count;
+    int op_capacity;
+} DataStoreBatch;
+
+typedef enum {
+    UNDO_ADD_CATEGORY,
+    UNDO_REMOVE_CATEGORY,
+    UNDO_ADD_SUBGROUP,
+    UNDO_REMOVE_SUBGROUP,
+    UNDO_ADD_PRODUCT,
+    UNDO_REMOVE_PRODUCT,
+    UNDO_UPDATE_PRODUCT
+} UndoKind;
+
+/**
+ * @brief What it takes to reverse one mutation
+ */
+typedef struct {
+    UndoKind kind;
+    int owner_id;              // Category ID for category/subgroup changes, subgroup ID for products
+    int index;                 // Array position a removed entity came from
+    union {
+        Category category;     // Removed categories/subgroups keep their memory until commit
+        Subgroup subgroup;
+        Product product;       // Removed product or the value before an update
+    } before;
+} UndoRecord;
+
+/**
+ * @brief An open transaction: holds the write lock and logs how to undo each change
+ */
+struct DataStoreTxn {
+    DataStore* store;
+    UndoRecord* records;
+    int record_count;
+    int record_capacity;
+    bool was_modified;         // store->is_modified at begin
+};
+
+/**
+ * @brief Range of IDs reserved by one thread, handed out without touching the store
+ */
+typedef struct {
+    IdKind kind;
+    int next;                  // Next ID to hand out
+    int end;                   // One past the last reserved ID
+    int batch;                 // IDs reserved per refill
+} IdBlock;
+
+/**
+ * @brief What a compaction pass gave back
+ */
+typedef struct {
+    size_t bytes_released;     // Reserved bytes returned to the allocator
+    int arrays_shrunk;
+    int ids_renumbered;        // Entities whose ID changed
+} CompactResult;
+
+#define LISTING_PAGE_SIZE 20
+
+/**
+ * @brief Window of a paged listing over the product order
+ *
+ * The product order is the hierarchy order: category by category, subgroup
+ * by subgroup. A page is found by skipping whole subgroups by their product
+ * counts and only its own products are formatted, so showing one costs
+ * O(subgroups + page size) and never waits for a scan table rebuild.
+ */
+typedef struct {
+    int offset;                // First product on the page, a multiple of page_size
+    int page_size;             // Products per page
+    int total;                 // Products in the listing when the page was last shown
+} PageCursor;
+
 // ============================================================================
 // Helper / I/O functions (public)
 // ============================================================================
 
 void trim_string(char* str);
-void get_current_timestamp(char* buffer, size_t size);
+void get_current_timestamp(char* buffer, size_t size);    // See timestamp_now
 void clear_screen(void);
 void pause_screen(void);
 
@@ -77,6 +243,236 @@ bool safe_input_string(const char* prompt, char* buffer, size_t size);
 bool safe_input_int(const char* prompt, int* value);
 bool safe_input_float(const char* prompt, float* value);
 
+// ============================================================================
+// Datastore versioning / flat scan table
+// ============================================================================
+
+/**
+ * @brief Flag the store as modified after an in-place edit
+ * @param store Pointer to DataStore
+ *
+ * Must be called after changing entities through pointers returned by the
+ * find/resolve functions. The scan table is dropped and rebuilt by the next
+ * scan; to change one product's fields, edit a copy and pass it to
+ * datastore_update_product instead.
+ */
+void datastore_mark_modified(DataStore* store);
+
+/**
+ * @brief Get the product scan table, rebuilding it if it was dropped
+ * @param store Pointer to DataStore
+ * @return Pointer to up-to-date table, NULL on allocation failure
+ */
+const ProductTable* datastore_get_product_table(DataStore* store);
+
+// ============================================================================
+// Datastore concurrency
+// ============================================================================
+
+/**
+ * @brief Allow the store to be shared between threads
+ * @param store Pointer to DataStore
+ * @return true if successful, false otherwise
+ *
+ * Afterwards searches, statistics, display and save take the shared lock
+ * and the datastore_* mutation functions take the exclusive lock. Functions
+ * that hand out pointers (find, handle, resolve, get_product_table) do not
+ * lock: hold datastore_read_lock around the call and every use of the
+ * result, or datastore_write_lock for in-place edits such as
+ * subgroup_add_product followed by datastore_mark_modified. The locks are
+ * not recursive, so never call a locking datastore_* function while holding
+ * either lock.
+ */
+bool datastore_enable_concurrency(DataStore* store);
+
+/**
+ * @brief Take/release the store lock (no-ops until concurrency is enabled)
+ * @param store Pointer to DataStore
+ */
+void datastore_read_lock(DataStore* store);
+void datastore_read_unlock(DataStore* store);
+void datastore_write_lock(DataStore* store);
+void datastore_write_unlock(DataStore* store);
+
+/**
+ * @brief Publish an immutable snapshot after every mutation (implies concurrency)
+ * @param store Pointer to DataStore
+ * @return true if successful, false otherwise
+ *
+ * datastore_display_all and datastore_save then work from a pinned snapshot
+ * and never hold the store lock while printing or writing the file.
+ */
+bool datastore_enable_snapshots(DataStore* store);
+
+/**
+ * @brief Pin the latest snapshot without taking any lock
+ * @param store Pointer to DataStore
+ * @param pin Output pin; pin->snapshot stays valid until unpinned
+ * @return true if successful, false if snapshots are off or no reader slot is free
+ */
+bool datastore_snapshot_pin(DataStore* store, SnapshotPin* pin);
+void datastore_snapshot_unpin(DataStore* store, SnapshotPin* pin);
+
+// ============================================================================
+// ID allocation (lock-free, safe from any thread)
+// ============================================================================
+
+/**
+ * @brief Allocate a fresh ID with one atomic fetch-add
+ * @param store Pointer to DataStore
+ * @param kind Entity kind
+ * @return New ID, 0 on failure
+ *
+ * IDs are never reused; one whose add fails is simply skipped.
+ */
+int datastore_allocate_id(DataStore* store, IdKind kind);
+
+/**
+ * @brief Prepare an empty per-thread ID block
+ * @param block Block to initialize
+ * @param kind Entity kind the block serves
+ * @param batch IDs to reserve per refill (at least 1)
+ */
+void id_block_init(IdBlock* block, IdKind kind, int batch);
+
+/**
+ * @brief Take the next ID from a block, reserving a new batch when it runs out
+ * @param store Pointer to DataStore
+ * @param block Block owned by the calling thread
+ * @return New ID, 0 on failure
+ *
+ * Unused IDs left in a block are skipped. Discard blocks after datastore_load,
+ * which resets the counters from the file.
+ */
+int datastore_allocate_id_from(DataStore* store, IdBlock* block);
+
+// ============================================================================
+// Batched product mutations
+// ============================================================================
+
+/**
+ * @brief Start an empty batch against a store
+ * @param batch Batch to initialize
+ * @param store Target store
+ */
+void datastore_batch_begin(DataStoreBatch* batch, DataStore* store);
+
+/**
+ * @brief Queue a new product (product.subgroup_id is set to subgroup_id)
+ * @return true if queued, false otherwise
+ */
+bool datastore_batch_add(DataStoreBatch* batch, int subgroup_id, Product product);
+
+/**
+ * @brief Queue a replacement for the product with the same ID
+ * @return true if queued, false otherwise
+ *
+ * The product stays in its subgroup and keeps its created_at; updated_at is
+ * set when the batch is committed.
+ */
+bool datastore_batch_update(DataStoreBatch* batch, Product product);
+
+/**
+ * @brief Queue removal of a product
+ * @return true if queued, false otherwise
+ */
+bool datastore_batch_remove(DataStoreBatch* batch, int product_id);
+
+/**
+ * @brief Validate and apply every queued operation as one change, then end the batch
+ * @param batch Batch to commit
+ * @return true if everything was applied, false if nothing was
+ *
+ * Runs under one exclusive lock. Each target subgroup grows once, handles
+ * are registered directly and the store version, scan table and snapshot
+ * change once for the whole batch. A product ID may appear only once per
+ * batch.
+ */
+bool datastore_batch_commit(DataStoreBatch* batch);
+
+/**
+ * @brief Drop all queued operations and end the batch
+ * @param batch Batch to discard
+ */
+void datastore_batch_discard(DataStoreBatch* batch);
+
+// ============================================================================
+// Transactions
+// ============================================================================
+
+/**
+ * @brief Open a transaction; takes the store's write lock until commit or abort
+ * @param txn Transaction to initialize
+ * @param store Target store
+ * @return true if successful, false otherwise
+ *
+ * While it is open the owning thread may use only datastore_txn_* and the
+ * find/handle functions on this store; other threads wait. Transactions do
+ * not nest. Snapshot readers keep seeing the state from before begin.
+ */
+bool datastore_txn_begin(DataStoreTxn* txn, DataStore* store);
+
+bool datastore_txn_add_category(DataStoreTxn* txn, Category category);
+bool datastore_txn_remove_category(DataStoreTxn* txn, int category_id);
+bool datastore_txn_add_subgroup(DataStoreTxn* txn, int category_id, Subgroup subgroup);
+bool datastore_txn_remove_subgroup(DataStoreTxn* txn, int subgroup_id);
+bool datastore_txn_add_product(DataStoreTxn* txn, int subgroup_id, Product product);
+bool datastore_txn_remove_product(DataStoreTxn* txn, int product_id);
+
+/**
+ * @brief Replace the product with the same ID; it stays in its subgroup
+ * @return true if successful, false otherwise
+ *
+ * The product keeps its created_at; updated_at is set to the current time.
+ */
+bool datastore_txn_update_product(DataStoreTxn* txn, Product product);
+
+/**
+ * @brief Move a product to another subgroup, keeping its ID
+ * @return true if successful, false otherwise
+ */
+bool datastore_txn_move_product(DataStoreTxn* txn, int product_id, int subgroup_id);
+
+/**
+ * @brief Keep every change, free what was removed and release the lock
+ * @param txn Transaction to commit
+ * @return true if successful, false if no transaction was open
+ */
+bool datastore_txn_commit(DataStoreTxn* txn);
+
+/**
+ * @brief Undo every change in reverse order and release the lock
+ * @param txn Transaction to abort
+ *
+ * Costs O(changes). Array order is restored exactly; IDs handed out by
+ * datastore_allocate_id stay used, and handles to entities that were
+ * removed and restored must be fetched again.
+ */
+void datastore_txn_abort(DataStoreTxn* txn);
+
+// ============================================================================
+// Compaction
+// ============================================================================
+
+/**
+ * @brief Shrink every over-allocated array and release cached scan storage
+ * @param store Pointer to DataStore
+ * @param renumber_ids Also renumber categories, subgroups and products 1..n
+ * @param result Receives what was released, may be NULL
+ * @return true if successful, false inside a transaction or when asked to
+ *         renumber a shard, whose IDs must stay on its stripe
+ *
+ * Holds the write lock for one pass over the store. Arrays keep at least
+ * their initial capacity. The scan table is freed and rebuilt by the next
+ * scan; on glibc the freed memory is then trimmed from the heap.
+ *
+ * Renumbering keeps the order of every array, marks the store modified and
+ * invalidates all handles, outstanding ID blocks and any IDs held outside
+ * the store: every handle slot moves to a new generation, so handles taken
+ * before resolve to NULL. Spare handle table capacity is released.
+ */
+bool datastore_compact(DataStore* store, bool renumber_ids, CompactResult* result);
+
 // ============================================================================
 // Datastore lookup / search / reporting
 // ============================================================================
@@ -85,14 +481,116 @@ Category* datastore_find_category_by_id(DataStore* store, int category_id);
 Subgroup* datastore_find_subgroup_by_id(DataStore* store, int subgroup_id);
 Product* datastore_find_product_by_id(DataStore* store, int product_id);
 
+/**
+ * @brief Find a product by its code
+ * @param store Pointer to DataStore
+ * @param code Product code, compared exactly
+ * @return First match in hierarchy order, NULL if none
+ *
+ * Walks every product, so it costs O(products). Lock like the other find functions.
+ */
+Product* datastore_find_product_by_code(DataStore* store, const char* code);
+
+// ============================================================================
+// Datastore handles (stable across realloc and swap-and-pop)
+// ============================================================================
+
+CategoryHandle datastore_get_category_handle(DataStore* store, int category_id);
+SubgroupHandle datastore_get_subgroup_handle(DataStore* store, int subgroup_id);
+ProductHandle datastore_get_product_handle(DataStore* store, int product_id);
+
+/**
+ * @brief Resolve a handle to the current entity address in O(1)
+ * @return Pointer valid until the next mutation, NULL if the entity was removed
+ */
+Category* datastore_resolve_category(DataStore* store, CategoryHandle handle);
+Subgroup* datastore_resolve_subgroup(DataStore* store, SubgroupHandle handle);
+Product* datastore_resolve_product(DataStore* store, ProductHandle handle);
+
+/**
+ * @brief Re-register every entity in the handle tables
+ * @param store Pointer to DataStore
+ *
+ * Needed after the hierarchy was modified without going through the
+ * datastore_* mutation functions. Invalidates all outstanding handles.
+ */
+void datastore_rebuild_handles(DataStore* store);
+
+/*
+ * Searches return copies of the matching products in hierarchy order:
+ * category array order, then subgroup, then product, as a walk of the
+ * store would visit them, regardless of the scan table's row order.
+ */
 SearchResult datastore_search_products_by_name(DataStore* store, const char* name);
 SearchResult datastore_search_products_by_price(DataStore* store, float min_price, float max_price);
 SearchResult datastore_search_products_by_quantity(DataStore* store, int min_qty, int max_qty);
 void search_result_free(SearchResult* result);
 
 Statistics datastore_get_statistics(DataStore* store);
+
+/**
+ * @brief Measure the memory held by a store
+ * @param store Pointer to DataStore
+ * @return Used and reserved bytes per level
+ *
+ * Walks every array and text field once under the read lock, so it costs a
+ * full scan; not for hot paths. Not available inside a transaction.
+ */
+MemoryReport datastore_memory_report(DataStore* store);
+
+/**
+ * @brief Print datastore_memory_report as a table
+ * @param store Pointer to DataStore
+ */
+void datastore_display_memory(DataStore* store);
 void datastore_display_all(DataStore* store);
 
+// ============================================================================
+// Paged listings
+// ============================================================================
+
+/**
+ * @brief Start a cursor on the first page
+ * @param cursor Cursor to initialize
+ * @param page_size Products per page, LISTING_PAGE_SIZE if not positive
+ */
+void page_cursor_init(PageCursor* cursor, int page_size);
+
+/**
+ * @brief Move by whole pages, stopping at the first and last page
+ * @param cursor Cursor
+ * @param pages Pages to move, negative to go back
+ * @return false if the cursor was already at the end it moved towards
+ */
+bool page_cursor_move(PageCursor* cursor, int pages);
+
+/**
+ * @brief Jump to a page, clamped to the pages that exist
+ * @param cursor Cursor
+ * @param page Zero-based page number
+ */
+void page_cursor_seek(PageCursor* cursor, int page);
+
+int page_cursor_page(const PageCursor* cursor);
+int page_cursor_page_count(const PageCursor* cursor);
+
+/**
+ * @brief Print one page of all products as a flat table
+ * @param store Pointer to DataStore
+ * @param cursor Page to show; offset and total are brought up to date first
+ */
+void datastore_display_products_page(DataStore* store, PageCursor* cursor);
+
+/**
+ * @brief Print one page of the hierarchical view
+ * @param store Pointer to DataStore
+ * @param cursor Page to show; offset and total are brought up to date first
+ *
+ * The page lists its products under their category and subgroup headings.
+ * Empty subgroups and categories appear at their place in the order.
+ */
+void datastore_display_hierarchy_page(DataStore* store, PageCursor* cursor);
+
 // ============================================================================
 // DataStore Management
 // ============================================================================
@@ -109,6 +607,14 @@ DataStore datastore_init(void);
  */
 void datastore_free(DataStore* store);
 
+/**
+ * @brief Run searches and statistics on worker threads
+ * @param store Pointer to DataStore
+ * @param thread_count Threads including the caller, 0 for one per CPU, 1 to disable
+ * @return true if successful, false otherwise
+ */
+bool datastore_set_thread_count(DataStore* store, int thread_count);
+
 /**
  * @brief Load data from file
  * @param store Pointer to DataStore
@@ -141,4 +647,49 @@ bool datastore_add_category(DataStore* store, Category category);
  */
 bool datastore_remove_category(DataStore* store, int category_id);
 
+/**
+ * @brief Add a subgroup to a category in the data store
+ * @param store Pointer to DataStore
+ * @param category_id Parent category ID
+ * @param subgroup Subgroup to add
+ * @return true if successful, false otherwise
+ */
+bool datastore_add_subgroup(DataStore* store, int category_id, Subgroup subgroup);
+
+/**
+ * @brief Remove a subgroup (and its products) from the data store
+ * @param store Pointer to DataStore
+ * @param subgroup_id Subgroup ID to remove
+ * @return true if successful, false otherwise
+ */
+bool datastore_remove_subgroup(DataStore* store, int subgroup_id);
+
+/**
+ * @brief Add a product to a subgroup in the data store
+ * @param store Pointer to DataStore
+ * @param subgroup_id Parent subgroup ID
+ * @param product Product to add
+ * @return true if successful, false otherwise
+ */
+bool datastore_add_product(DataStore* store, int subgroup_id, Product product);
+
+/**
+ * @brief Remove a product from the data store
+ * @param store Pointer to DataStore
+ * @param product_id Product ID to remove
+ * @return true if successful, false otherwise
+ */
+bool datastore_remove_product(DataStore* store, int product_id);
+
+/**
+ * @brief Replace the product with the same ID; it stays in its subgroup
+ * @param store Pointer to DataStore
+ * @param product New product values, usually an edited copy of the stored one
+ * @return true if successful, false otherwise
+ *
+ * The product keeps its created_at; updated_at is set to the current time.
+ * Only the product's scan table row is rewritten.
+ */
+bool datastore_update_product(DataStore* store, Product product);
+
 #endif // UTILS_H
\ No newline at end of file
@@ -1,4 +1,6 @@
 #include "../include/category.h"
+#include "../include/metrics.h"
+#include "../include/render.h"
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
@@ -57,7 +59,7 @@ Category category_create(int id, const char* name, const char* description) {
     return category;
 }
 
-bool category_add_subgroup(Category* category, Subgroup subgroup) {
+static bool add_subgroup(Category* category, Subgroup subgroup) {
     if (!category) {
         fprintf(stderr, "Error: Category pointer is NULL\n");
         return false;
@@ -89,7 +91,31 @@ bool category_add_subgroup(Category* category, Subgroup subgroup) {
     return true;
 }
 
+bool category_add_subgroup(Category* category, Subgroup subgroup) {
+    MetricTimer timer = METRICS_START();
+    bool ok = add_subgroup(category, subgroup);
+    METRICS_STOP(METRIC_CATEGORY_ADD_SUBGROUP, timer, ok);
+    return ok;
+}
+
+static bool remove_subgroup(Category* category, int subgroup_id) {
+    Subgroup removed;
+    if (!category_detach_subgroup(category, subgroup_id, &removed)) {
+        return false;
+    }
+    
+    subgroup_free(&removed);
+    return true;
+}
+
 bool category_remove_subgroup(Category* category, int subgroup_id) {
+    MetricTimer timer = METRICS_START();
+    bool ok = remove_subgroup(category, subgroup_id);
+    METRICS_STOP(METRIC_CATEGORY_REMOVE_SUBGROUP, timer, ok);
+    return ok;
+}
+
+bool category_detach_subgroup(Category* category, int subgroup_id, Subgroup* removed) {
     if (!category) {
         fprintf(stderr, "Error: Category pointer is NULL\n");
         return false;
@@ -114,8 +140,7 @@ bool category_remove_subgroup(Category* category, int subgroup_id) {
         return false;
     }
     
-    // Free the subgroup to be removed
-    subgroup_free(&category->subgroups[index]);
+    *removed = category->subgroups[index];
     
     // Swap with last element (O(1) operation)
     int last_index = category->subgroup_count - 1;
@@ -128,7 +153,24 @@ bool category_remove_subgroup(Category* category, int subgroup_id) {
     return true;
 }
 
-Subgroup* category_find_subgroup_by_id(Category* category, int subgroup_id) {
+size_t category_shrink_to_fit(Category* category) {
+    if (!category || !category->subgroups) return 0;
+    
+    int new_capacity = category->subgroup_count > INITIAL_SUBGROUP_CAPACITY ?
+                       category->subgroup_count : INITIAL_SUBGROUP_CAPACITY;
+    if (new_capacity >= category->subgroup_capacity) return 0;
+    
+    // A failed shrink leaves the old, larger array in place
+    Subgroup* new_subgroups = (Subgroup*)realloc(category->subgroups, new_capacity * sizeof(Subgroup));
+    if (!new_subgroups) return 0;
+    
+    size_t released = (size_t)(category->subgroup_capacity - new_capacity) * sizeof(Subgroup);
+    category->subgroups = new_subgroups;
+    category->subgroup_capacity = new_capacity;
+    return released;
+}
+
+static Subgroup* find_subgroup_by_id(Category* category, int subgroup_id) {
     if (!category) {
         return NULL;
     }
@@ -142,22 +184,30 @@ Subgroup* category_find_subgroup_by_id(Category* category, int subgroup_id) {
     return NULL;
 }
 
+Subgroup* category_find_subgroup_by_id(Category* category, int subgroup_id) {
+    MetricTimer timer = METRICS_START();
+    Subgroup* found = find_subgroup_by_id(category, subgroup_id);
+    METRICS_STOP(METRIC_CATEGORY_FIND_SUBGROUP, timer, found != NULL);
+    return found;
+}
+
 void category_display(const Category* category) {
     if (!category) {
-        printf("Error: Category pointer is NULL\n");
+        render_printf("Error: Category pointer is NULL\n");
         return;
     }
     
-    printf("\n╔══════════════════════════════════════════════════════════╗\n");
-    printf(  "║  Category Information                                    ║\n");
-    printf(  "╚══════════════════════════════════════════════════════════╝\n");
-    printf("  ID:          %d\n", category->id);
-    printf("  Name:        %s\n", category->name);
-    printf("  Description: %s\n", category->description);
-    printf("  Subgroups:   %d (Capacity: %d)\n", category->subgroup_count, category->subgroup_capacity);
+    render_begin();
+    render_printf("\n╔══════════════════════════════════════════════════════════╗\n");
+    render_printf(  "║  Category Information                                    ║\n");
+    render_printf(  "╚══════════════════════════════════════════════════════════╝\n");
+    render_printf("  ID:          %d\n", category->id);
+    render_printf("  Name:        %s\n", category->name);
+    render_printf("  Description: %s\n", category->description);
+    render_printf("  Subgroups:   %d (Capacity: %d)\n", category->subgroup_count, category->subgroup_capacity);
     
     if (category->subgroup_count > 0) {
-        printf("\n  Subgroups in this category:\n");
+        render_printf("\n  Subgroups in this category:\n");
         subgroup_display_table_header();
         for (int i = 0; i < category->subgroup_count; i++) {
             subgroup_display_table_row(&category->subgroups[i]);
@@ -167,9 +217,9 @@ void category_display(const Category* category) {
         // Display products in each subgroup
         for (int i = 0; i < category->subgroup_count; i++) {
             if (category->subgroups[i].product_count > 0) {
-                printf("\n  Products in '%s' (Subgroup ID: %d):\n", 
-                       category->subgroups[i].name, 
-                       category->subgroups[i].id);
+                render_printf("\n  Products in '%s' (Subgroup ID: %d):\n", 
+                              category->subgroups[i].name, 
+                              category->subgroups[i].id);
                 product_display_table_header();
                 for (int j = 0; j < category->subgroups[i].product_count; j++) {
                     product_display_table_row(&category->subgroups[i].products[j]);
@@ -178,29 +228,30 @@ void category_display(const Category* category) {
             }
         }
     }
-    printf("\n");
+    render_printf("\n");
+    render_end();
 }
 
 void category_display_table_header(void) {
-    printf("  ┌────────┬──────────────────────────────────────────────────┬───────────┐\n");
-    printf("  │   ID   │ Category Name                                    │ Subgroups │\n");
-    printf("  ├────────┼──────────────────────────────────────────────────┼───────────┤\n");
+    render_printf("  ┌────────┬──────────────────────────────────────────────────┬───────────┐\n");
+    render_printf("  │   ID   │ Category Name                                    │ Subgroups │\n");
+    render_printf("  ├────────┼──────────────────────────────────────────────────┼───────────┤\n");
 }
 
 void category_display_table_row(const Category* category) {
     if (!category) return;
     
-    printf("  │ %-6d │ %-48s │ %-9d │\n",
-           category->id,
-           category->name,
-           category->subgroup_count);
+    render_printf("  │ %-6d │ %-48s │ %-9d │\n",
+                  category->id,
+                  category->name,
+                  category->subgroup_count);
 }
 
 void category_display_table_footer(void) {
-    printf("  └────────┴──────────────────────────────────────────────────┴───────────┘\n");
+    render_printf("  └────────┴──────────────────────────────────────────────────┴───────────┘\n");
 }
 
-bool category_update_name(Category* category, const char* name) {
+static bool update_name(Category* category, const char* name) {
     if (!category) {
         fprintf(stderr, "Error: Category pointer is NULL\n");
         return false;
@@ -223,7 +274,14 @@ bool category_update_name(Category* category, const char* name) {
     return true;
 }
 
-bool category_update_description(Category* category, const char* description) {
+bool category_update_name(Category* category, const char* name) {
+    MetricTimer timer = METRICS_START();
+    bool ok = update_name(category, name);
+    METRICS_STOP(METRIC_CATEGORY_UPDATE_NAME, timer, ok);
+    return ok;
+}
+
+static bool update_description(Category* category, const char* description) {
     if (!category) {
         fprintf(stderr, "Error: Category pointer is NULL\n");
         return false;
@@ -240,6 +298,13 @@ bool category_update_description(Category* category, const char* description) {
     return true;
 }
 
+bool category_update_description(Category* category, const char* description) {
+    MetricTimer timer = METRICS_START();
+    bool ok = update_description(category, description);
+    METRICS_STOP(METRIC_CATEGORY_UPDATE_DESCRIPTION, timer, ok);
+    return ok;
+}
+
 bool category_is_valid(const Category* category) {
     if (!category) {
         return false;
@@ -0,0 +1,559 @@
+/**
+ * @file command.c
+ * @brief Non-interactive command mode implementation
+ * @author PMS Team
+ * @date 2025
+ * @compatible Dev-C++ 6.3, TDM-GCC 9.2.0, C11
+ */
+
+#include "../include/command.h"
+#include "../include/server.h"
+#include "../include/metrics.h"
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <errno.h>
+#include <limits.h>
+
+// ============================================================================
+// Argument Parsing
+// ============================================================================
+
+static void command_error(const CommandContext* ctx, const char* message, const char* detail) {
+    if (ctx->line > 0) {
+        fprintf(stderr, "Error: line %d: %s%s\n", ctx->line, message, detail ? detail : "");
+    } else {
+        fprintf(stderr, "Error: %s%s\n", message, detail ? detail : "");
+    }
+}
+
+static bool parse_int(const CommandContext* ctx, const char* text, int* value) {
+    char* end;
+    errno = 0;
+    long parsed = strtol(text, &end, 10);
+
+    if (end == text || *end != '\0' || errno == ERANGE || parsed < INT_MIN || parsed > INT_MAX) {
+        command_error(ctx, "Not an integer: ", text);
+        return false;
+    }
+
+    *value = (int)parsed;
+    return true;
+}
+
+static bool parse_float(const CommandContext* ctx, const char* text, float* value) {
+    char* end;
+    errno = 0;
+    float parsed = strtof(text, &end);
+
+    if (end == text || *end != '\0' || errno == ERANGE) {
+        command_error(ctx, "Not a number: ", text);
+        return false;
+    }
+
+    *value = parsed;
+    return true;
+}
+
+/**
+ * @brief Split a line in place into whitespace-separated, optionally quoted arguments
+ * @return Number of arguments, -1 on error
+ */
+static int split_arguments(const CommandContext* ctx, char* line, char** argv, int max_args) {
+    int argc = 0;
+    char* p = line;
+
+    while (true) {
+        while (isspace((unsigned char)*p)) p++;
+        if (*p == '\0' || *p == '#') break;
+
+        if (argc >= max_args) {
+            command_error(ctx, "Too many arguments", NULL);
+            return -1;
+        }
+
+        if (*p == '"') {
+            argv[argc++] = ++p;
+            char* close = strchr(p, '"');
+            if (!close) {
+                command_error(ctx, "Unterminated quote", NULL);
+                return -1;
+            }
+            *close = '\0';
+            p = close + 1;
+        } else {
+            argv[argc++] = p;
+            while (*p && !isspace((unsigned char)*p)) p++;
+            if (*p) *p++ = '\0';
+        }
+    }
+
+    return argc;
+}
+
+// ============================================================================
+// Output
+// ============================================================================
+
+static void print_product(FILE* out, const Product* product) {
+    fprintf(out, "%d\t%d\t%s\t%s\t%.2f\t%d\n", product->id, product->subgroup_id,
+            product->code, product->name, product->price, product->quantity);
+}
+
+static void print_result(FILE* out, SearchResult* result) {
+    for (int i = 0; i < result->count; i++) {
+        print_product(out, &result->products[i]);
+    }
+    search_result_free(result);
+}
+
+// ============================================================================
+// Commands
+// ============================================================================
+
+static bool cmd_add_category(CommandContext* ctx, int argc, char** argv) {
+    (void)argc;
+    Category category = category_create(datastore_allocate_id(ctx->store, ID_CATEGORY), argv[1], argv[2]);
+    if (!datastore_add_category(ctx->store, category)) {
+        category_free(&category);
+        return false;
+    }
+
+    fprintf(ctx->out, "%d\n", category.id);
+    return true;
+}
+
+static bool cmd_add_subgroup(CommandContext* ctx, int argc, char** argv) {
+    (void)argc;
+    int category_id;
+    if (!parse_int(ctx, argv[1], &category_id)) return false;
+
+    Subgroup subgroup = subgroup_create(datastore_allocate_id(ctx->store, ID_SUBGROUP), category_id, argv[2], argv[3]);
+    if (!datastore_add_subgroup(ctx->store, category_id, subgroup)) {
+        subgroup_free(&subgroup);
+        return false;
+    }
+
+    fprintf(ctx->out, "%d\n", subgroup.id);
+    return true;
+}
+
+static bool cmd_add_product(CommandContext* ctx, int argc, char** argv) {
+    (void)argc;
+    int subgroup_id, quantity;
+    float price;
+
+    if (!parse_int(ctx, argv[1], &subgroup_id) ||
+        !parse_float(ctx, argv[5], &price) ||
+        !parse_int(ctx, argv[6], &quantity)) {
+        return false;
+    }
+
+    Product product = product_create(datastore_allocate_id(ctx->store, ID_PRODUCT), subgroup_id,
+                                     argv[2], argv[3], argv[4], price, quantity);
+    if (!datastore_add_product(ctx->store, subgroup_id, product)) {
+        return false;
+    }
+
+    fprintf(ctx->out, "%d\n", product.id);
+    return true;
+}
+
+static bool cmd_update_product(CommandContext* ctx, int argc, char** argv) {
+    (void)argc;
+    int id;
+    if (!parse_int(ctx, argv[1], &id)) return false;
+
+    const char* field = argv[2];
+    const char* value = argv[3];
+    int quantity = 0;
+    float price = 0.0f;
+
+    if ((strcmp(field, "price") == 0 && !parse_float(ctx, value, &price)) ||
+        (strcmp(field, "quantity") == 0 && !parse_int(ctx, value, &quantity))) {
+        return false;
+    }
+
+    // Edit a copy; datastore_update_product stores it and patches the scan row
+    Product product;
+    datastore_read_lock(ctx->store);
+    Product* current = datastore_find_product_by_id(ctx->store, id);
+    if (current) {
+        product = *current;
+    }
+    datastore_read_unlock(ctx->store);
+
+    if (!current) {
+        fprintf(stderr, "Error: Product ID %d not found\n", id);
+        return false;
+    }
+
+    bool ok = false;
+    if (strcmp(field, "code") == 0) {
+        ok = product_update_code(&product, value);
+    } else if (strcmp(field, "name") == 0) {
+        ok = product_update_name(&product, value);
+    } else if (strcmp(field, "description") == 0) {
+        ok = product_update_description(&product, value);
+    } else if (strcmp(field, "price") == 0) {
+        ok = product_update_price(&product, price);
+    } else if (strcmp(field, "quantity") == 0) {
+        ok = product_update_quantity(&product, quantity);
+    } else {
+        command_error(ctx, "Unknown product field: ", field);
+    }
+
+    return ok && datastore_update_product(ctx->store, product);
+}
+
+static bool cmd_remove_category(CommandContext* ctx, int argc, char** argv) {
+    (void)argc;
+    int id;
+    return parse_int(ctx, argv[1], &id) && datastore_remove_category(ctx->store, id);
+}
+
+static bool cmd_remove_subgroup(CommandContext* ctx, int argc, char** argv) {
+    (void)argc;
+    int id;
+    return parse_int(ctx, argv[1], &id) && datastore_remove_subgroup(ctx->store, id);
+}
+
+static bool cmd_remove_product(CommandContext* ctx, int argc, char** argv) {
+    (void)argc;
+    int id;
+    return parse_int(ctx, argv[1], &id) && datastore_remove_product(ctx->store, id);
+}
+
+static bool cmd_find(CommandContext* ctx, int argc, char** argv) {
+    (void)argc;
+    int id;
+    if (!parse_int(ctx, argv[1], &id)) return false;
+
+    datastore_read_lock(ctx->store);
+    Product* product = datastore_find_product_by_id(ctx->store, id);
+    if (product) {
+        print_product(ctx->out, product);
+    }
+    datastore_read_unlock(ctx->store);
+
+    if (!product) {
+        fprintf(stderr, "Error: Product ID %d not found\n", id);
+        return false;
+    }
+    return true;
+}
+
+static bool cmd_find_code(CommandContext* ctx, int argc, char** argv) {
+    (void)argc;
+
+    datastore_read_lock(ctx->store);
+    const Product* found = datastore_find_product_by_code(ctx->store, argv[1]);
+    if (found) {
+        print_product(ctx->out, found);
+    }
+    datastore_read_unlock(ctx->store);
+
+    if (!found) {
+        command_error(ctx, "Product code not found: ", argv[1]);
+        return false;
+    }
+    return true;
+}
+
+static bool cmd_search_name(CommandContext* ctx, int argc, char** argv) {
+    (void)argc;
+    SearchResult result = datastore_search_products_by_name(ctx->store, argv[1]);
+    print_result(ctx->out, &result);
+    return true;
+}
+
+static bool cmd_search_price(CommandContext* ctx, int argc, char** argv) {
+    (void)argc;
+    float min_price, max_price;
+    if (!parse_float(ctx, argv[1], &min_price) || !parse_float(ctx, argv[2], &max_price)) {
+        return false;
+    }
+
+    SearchResult result = datastore_search_products_by_price(ctx->store, min_price, max_price);
+    print_result(ctx->out, &result);
+    return true;
+}
+
+static bool cmd_search_quantity(CommandContext* ctx, int argc, char** argv) {
+    (void)argc;
+    int min_qty, max_qty;
+    if (!parse_int(ctx, argv[1], &min_qty) || !parse_int(ctx, argv[2], &max_qty)) {
+        return false;
+    }
+
+    SearchResult result = datastore_search_products_by_quantity(ctx->store, min_qty, max_qty);
+    print_result(ctx->out, &result);
+    return true;
+}
+
+static bool cmd_stats(CommandContext* ctx, int argc, char** argv) {
+    (void)argc;
+    (void)argv;
+    Statistics stats = datastore_get_statistics(ctx->store);
+
+    fprintf(ctx->out, "categories\t%d\n", stats.total_categories);
+    fprintf(ctx->out, "subgroups\t%d\n", stats.total_subgroups);
+    fprintf(ctx->out, "products\t%d\n", stats.total_products);
+    fprintf(ctx->out, "total_value\t%.2f\n", stats.total_value);
+    fprintf(ctx->out, "average_price\t%.2f\n", stats.average_price);
+    fprintf(ctx->out, "total_quantity\t%d\n", stats.total_quantity);
+    return true;
+}
+
+static void print_memory(FILE* out, const char* level, const MemoryUsage* usage) {
+    fprintf(out, "%s\t%zu\t%zu\t%lld\n", level, usage->used, usage->reserved, usage->allocations);
+}
+
+static bool cmd_memory(CommandContext* ctx, int argc, char** argv) {
+    (void)argc;
+    (void)argv;
+    MemoryReport report = datastore_memory_report(ctx->store);
+
+    print_memory(ctx->out, "categories", &report.categories);
+    print_memory(ctx->out, "subgroups", &report.subgroups);
+    print_memory(ctx->out, "products", &report.products);
+    print_memory(ctx->out, "handles", &report.handles);
+    print_memory(ctx->out, "scan_table", &report.scan_table);
+    print_memory(ctx->out, "snapshots", &report.snapshots);
+    print_memory(ctx->out, "strings", &report.strings);
+    print_memory(ctx->out, "total", &report.total);
+    return true;
+}
+
+static bool cmd_compact(CommandContext* ctx, int argc, char** argv) {
+    bool renumber = false;
+    if (argc > 1) {
+        if (strcmp(argv[1], "renumber") != 0) {
+            command_error(ctx, "Expected renumber: ", argv[1]);
+            return false;
+        }
+        renumber = true;
+    }
+
+    CompactResult result;
+    if (!datastore_compact(ctx->store, renumber, &result)) return false;
+
+    fprintf(ctx->out, "bytes_released\t%zu\n", result.bytes_released);
+    fprintf(ctx->out, "arrays_shrunk\t%d\n", result.arrays_shrunk);
+    fprintf(ctx->out, "ids_renumbered\t%d\n", result.ids_renumbered);
+    return true;
+}
+
+static bool cmd_save(CommandContext* ctx, int argc, char** argv) {
+    return datastore_save(ctx->store, argc > 1 ? argv[1] : ctx->data_file);
+}
+
+static bool cmd_metrics(CommandContext* ctx, int argc, char** argv) {
+    const char* action = argc > 1 ? argv[1] : "text";
+
+    if (strcmp(action, "text") == 0) {
+        metrics_dump(ctx->out, METRICS_TEXT);
+    } else if (strcmp(action, "json") == 0) {
+        metrics_dump(ctx->out, METRICS_JSON);
+    } else if (strcmp(action, "on") == 0 || strcmp(action, "off") == 0) {
+        metrics_set_enabled(strcmp(action, "on") == 0);
+    } else if (strcmp(action, "reset") == 0) {
+        metrics_reset();
+    } else {
+        command_error(ctx, "Expected text, json, on, off or reset: ", action);
+        return false;
+    }
+    return true;
+}
+
+typedef bool (*CommandHandler)(CommandContext* ctx, int argc, char** argv);
+
+typedef struct {
+    const char* name;
+    int min_args;              // Including the command name
+    int max_args;
+    CommandHandler handler;
+} CommandSpec;
+
+static const CommandSpec COMMANDS[] = {
+    {"add-category",    3, 3, cmd_add_category},
+    {"add-subgroup",    4, 4, cmd_add_subgroup},
+    {"add-product",     7, 7, cmd_add_product},
+    {"update-product",  4, 4, cmd_update_product},
+    {"remove-category", 2, 2, cmd_remove_category},
+    {"remove-subgroup", 2, 2, cmd_remove_subgroup},
+    {"remove-product",  2, 2, cmd_remove_product},
+    {"find",            2, 2, cmd_find},
+    {"find-code",       2, 2, cmd_find_code},
+    {"search-name",     2, 2, cmd_search_name},
+    {"search-price",    3, 3, cmd_search_price},
+    {"search-quantity", 3, 3, cmd_search_quantity},
+    {"stats",           1, 1, cmd_stats},
+    {"memory",          1, 1, cmd_memory},
+    {"compact",         1, 2, cmd_compact},
+    {"save",            1, 2, cmd_save},
+    {"metrics",         1, 2, cmd_metrics},
+};
+
+#define COMMAND_COUNT ((int)(sizeof(COMMANDS) / sizeof(COMMANDS[0])))
+
+// ============================================================================
+// Dispatch
+// ============================================================================
+
+bool command_execute(CommandContext* ctx, int argc, char** argv) {
+    if (!ctx || !ctx->store || argc <= 0) {
+        fprintf(stderr, "Error: Invalid parameters for command\n");
+        return false;
+    }
+
+    for (int i = 0; i < COMMAND_COUNT; i++) {
+        const CommandSpec* spec = &COMMANDS[i];
+        if (strcmp(argv[0], spec->name) != 0) continue;
+
+        if (argc < spec->min_args || argc > spec->max_args) {
+            command_error(ctx, "Wrong number of arguments for ", spec->name);
+            return false;
+        }
+        return spec->handler(ctx, argc, argv);
+    }
+
+    command_error(ctx, "Unknown command: ", argv[0]);
+    return false;
+}
+
+bool command_execute_line(CommandContext* ctx, char* line) {
+    char* argv[COMMAND_MAX_ARGS];
+    int argc = split_arguments(ctx, line, argv, COMMAND_MAX_ARGS);
+
+    if (argc < 0) return false;
+    if (argc == 0) return true;
+    return command_execute(ctx, argc, argv);
+}
+
+bool command_run_script(CommandContext* ctx, FILE* input) {
+    char line[COMMAND_LINE_SIZE];
+    ctx->line = 0;
+
+    while (fgets(line, sizeof(line), input)) {
+        ctx->line++;
+
+        size_t len = strlen(line);
+        if (len == sizeof(line) - 1 && line[len - 1] != '\n' && !feof(input)) {
+            command_error(ctx, "Line too long", NULL);
+            return false;
+        }
+
+        if (!command_execute_line(ctx, line)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static void print_usage(const char* program) {
+    fprintf(stderr, "Usage: %s [--data FILE] --script FILE|-\n", program);
+    fprintf(stderr, "       %s [--data FILE] <command> [arguments...]\n", program);
+    fprintf(stderr, "       %s [--data FILE] --serve PORT|SOCKET_PATH\n", program);
+    fprintf(stderr, "       %s --connect PORT|SOCKET_PATH [--script FILE|-]\n", program);
+    fprintf(stderr, "Commands:\n");
+    for (int i = 0; i < COMMAND_COUNT; i++) {
+        fprintf(stderr, "  %s\n", COMMANDS[i].name);
+    }
+}
+
+static FILE* open_script(const char* script) {
+    FILE* input = strcmp(script, "-") == 0 ? stdin : fopen(script, "r");
+    if (!input) {
+        fprintf(stderr, "Error: Cannot open script %s\n", script);
+    }
+    return input;
+}
+
+int command_main(int argc, char** argv, const char* default_data_file) {
+    const char* data_file = default_data_file;
+    const char* script = NULL;
+    const char* serve_address = NULL;
+    const char* connect_address = NULL;
+    int first = 1;
+
+    while (first < argc && strncmp(argv[first], "--", 2) == 0 && first + 1 < argc) {
+        const char* option = argv[first];
+        const char* value = argv[first + 1];
+
+        if (strcmp(option, "--data") == 0) data_file = value;
+        else if (strcmp(option, "--script") == 0) script = value;
+        else if (strcmp(option, "--serve") == 0) serve_address = value;
+        else if (strcmp(option, "--connect") == 0) connect_address = value;
+        else break;
+
+        first += 2;
+    }
+
+    bool has_command = first < argc;
+    bool valid;
+    if (connect_address) {
+        valid = !has_command && !serve_address;
+    } else if (serve_address) {
+        valid = !has_command && !script;
+    } else {
+        valid = has_command != (script != NULL);
+    }
+
+    if (!valid || (has_command && strncmp(argv[first], "--", 2) == 0)) {
+        print_usage(argv[0]);
+        return 2;
+    }
+
+    // The client only forwards lines, so it needs no store
+    if (connect_address) {
+        FILE* input = open_script(script ? script : "-");
+        if (!input) return 1;
+
+        bool ok = client_run(connect_address, input);
+        if (input != stdin) fclose(input);
+        return ok ? 0 : 1;
+    }
+
+    // PMS_METRICS=text|json collects from the start and dumps to stderr on exit
+    const char* metrics_format = getenv("PMS_METRICS");
+    if (metrics_format && *metrics_format) {
+        metrics_set_enabled(true);
+    }
+
+    DataStore store = datastore_init();
+    store.quiet = true;
+    if (!datastore_load(&store, data_file)) {
+        datastore_free(&store);
+        return 1;
+    }
+
+    CommandContext ctx;
+    ctx.store = &store;
+    ctx.data_file = data_file;
+    ctx.out = stdout;
+    ctx.line = 0;
+
+    bool ok;
+    if (serve_address) {
+        ok = server_run(&store, serve_address, data_file);
+    } else if (script) {
+        FILE* input = open_script(script);
+        if (!input) {
+            datastore_free(&store);
+            return 1;
+        }
+
+        ok = command_run_script(&ctx, input);
+        if (input != stdin) fclose(input);
+    } else {
+        ok = command_execute(&ctx, argc - first, argv + first);
+    }
+
+    datastore_free(&store);
+    if (metrics_format && *metrics_format) {
+        metrics_dump(stderr, strcmp(metrics_format, "json") == 0 ? METRICS_JSON : METRICS_TEXT);
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,305 @@
+/**
+ * @file handle.c
+ * @brief Generational handle table implementation
+ * @author PMS Team
+ * @date 2025
+ * @compatible Dev-C++ 6.3, TDM-GCC 9.2.0, C11
+ */
+
+#include "../include/handle.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <limits.h>
+
+#define INITIAL_SLOT_CAPACITY 16
+#define INITIAL_ID_MAP_CAPACITY 64
+#define MAX_ID_MAP_CAPACITY (1 << 30)
+
+void handle_table_init(HandleTable* table) {
+    if (!table) return;
+
+    table->slots = NULL;
+    table->slot_count = 0;
+    table->slot_capacity = 0;
+    table->free_head = HANDLE_INVALID_INDEX;
+    table->id_map = NULL;
+    table->id_map_capacity = 0;
+    table->id_map_count = 0;
+}
+
+void handle_table_free(HandleTable* table) {
+    if (!table) return;
+
+    free(table->slots);
+    free(table->id_map);
+    handle_table_init(table);
+}
+
+void handle_table_clear(HandleTable* table) {
+    if (!table) return;
+
+    // Keep the slots so old handles see a bumped generation, not a reused one
+    table->free_head = HANDLE_INVALID_INDEX;
+    for (int i = table->slot_count - 1; i >= 0; i--) {
+        HandleSlot* slot = &table->slots[i];
+        if (slot->id != 0) {
+            slot->generation++;
+            slot->id = 0;
+        }
+        slot->next_free = table->free_head;
+        table->free_head = i;
+    }
+
+    if (table->id_map) {
+        memset(table->id_map, 0, (size_t)table->id_map_capacity * sizeof(HandleIdEntry));
+    }
+    table->id_map_count = 0;
+}
+
+// ============================================================================
+// ID Map
+// ============================================================================
+
+/**
+ * @brief Home bucket of an ID (Fibonacci hashing; sequential IDs spread out)
+ */
+static size_t id_bucket(int id, int capacity) {
+    return (size_t)(((uint32_t)id * 2654435769u) & (uint32_t)(capacity - 1));
+}
+
+/**
+ * @brief Bucket holding id, or the empty bucket where it would go
+ */
+static size_t id_map_find(const HandleIdEntry* map, int capacity, int id) {
+    size_t mask = (size_t)capacity - 1;
+    size_t i = id_bucket(id, capacity);
+    while (map[i].id != 0 && map[i].id != id) {
+        i = (i + 1) & mask;
+    }
+    return i;
+}
+
+/**
+ * @brief Make room for count more IDs, keeping the map at most half full
+ */
+static bool ensure_id_map_room(HandleTable* table, int count) {
+    size_t needed = ((size_t)table->id_map_count + (size_t)count) * 2;
+    if (needed <= (size_t)table->id_map_capacity) return true;
+
+    size_t new_capacity = table->id_map_capacity > 0 ? (size_t)table->id_map_capacity
+                                                     : INITIAL_ID_MAP_CAPACITY;
+    while (new_capacity < needed && new_capacity <= MAX_ID_MAP_CAPACITY) {
+        new_capacity *= 2;
+    }
+    if (new_capacity > MAX_ID_MAP_CAPACITY) {
+        fprintf(stderr, "Error: Handle ID map is full\n");
+        return false;
+    }
+
+    HandleIdEntry* new_map = (HandleIdEntry*)calloc(new_capacity, sizeof(HandleIdEntry));
+    if (!new_map) {
+        fprintf(stderr, "Error: Failed to expand handle ID map\n");
+        return false;
+    }
+
+    for (int i = 0; i < table->id_map_capacity; i++) {
+        const HandleIdEntry* entry = &table->id_map[i];
+        if (entry->id != 0) {
+            new_map[id_map_find(new_map, (int)new_capacity, entry->id)] = *entry;
+        }
+    }
+
+    free(table->id_map);
+    table->id_map = new_map;
+    table->id_map_capacity = (int)new_capacity;
+    return true;
+}
+
+/**
+ * @brief Remove the entry in bucket i, shifting later entries of the run back
+ *
+ * Backward-shift deletion leaves no tombstones, so lookups never slow down
+ * after many removals.
+ */
+static void id_map_erase(HandleTable* table, size_t i) {
+    HandleIdEntry* map = table->id_map;
+    size_t mask = (size_t)table->id_map_capacity - 1;
+    size_t hole = i;
+
+    for (size_t j = (i + 1) & mask; map[j].id != 0; j = (j + 1) & mask) {
+        size_t home = id_bucket(map[j].id, table->id_map_capacity);
+        // Move j into the hole unless its home lies cyclically in (hole, j]
+        bool stays = hole <= j ? (home > hole && home <= j) : (home > hole || home <= j);
+        if (!stays) {
+            map[hole] = map[j];
+            hole = j;
+        }
+    }
+
+    map[hole].id = 0;
+    map[hole].slot = HANDLE_INVALID_INDEX;
+    table->id_map_count--;
+}
+
+// ============================================================================
+// Slots
+// ============================================================================
+
+/**
+ * @brief Make the slot array hold count more slots beyond slot_count
+ */
+static bool ensure_slot_room(HandleTable* table, int count) {
+    size_t needed = (size_t)table->slot_count + (size_t)count;
+    if (needed <= (size_t)table->slot_capacity) return true;
+
+    size_t new_capacity = table->slot_capacity > 0 ? (size_t)table->slot_capacity
+                                                   : INITIAL_SLOT_CAPACITY;
+    while (new_capacity < needed && new_capacity <= INT_MAX) {
+        new_capacity *= 2;
+    }
+    if (new_capacity > INT_MAX) {
+        fprintf(stderr, "Error: Handle table is full\n");
+        return false;
+    }
+
+    HandleSlot* new_slots = (HandleSlot*)realloc(table->slots, new_capacity * sizeof(HandleSlot));
+    if (!new_slots) {
+        fprintf(stderr, "Error: Failed to expand handle table\n");
+        return false;
+    }
+
+    table->slots = new_slots;
+    table->slot_capacity = (int)new_capacity;
+    return true;
+}
+
+size_t handle_table_shrink_to_fit(HandleTable* table) {
+    if (!table) return 0;
+
+    size_t released = 0;
+
+    int slot_capacity = table->slot_count > INITIAL_SLOT_CAPACITY ? table->slot_count : INITIAL_SLOT_CAPACITY;
+    if (table->slots && slot_capacity < table->slot_capacity) {
+        HandleSlot* new_slots = (HandleSlot*)realloc(table->slots, (size_t)slot_capacity * sizeof(HandleSlot));
+        if (new_slots) {
+            released += (size_t)(table->slot_capacity - slot_capacity) * sizeof(HandleSlot);
+            table->slots = new_slots;
+            table->slot_capacity = slot_capacity;
+        }
+    }
+
+    // Rehash into the smallest map that is at most half full
+    size_t map_capacity = INITIAL_ID_MAP_CAPACITY;
+    while (map_capacity < (size_t)table->id_map_count * 2) {
+        map_capacity *= 2;
+    }
+    if (table->id_map && map_capacity < (size_t)table->id_map_capacity) {
+        HandleIdEntry* new_map = (HandleIdEntry*)calloc(map_capacity, sizeof(HandleIdEntry));
+        if (new_map) {
+            for (int i = 0; i < table->id_map_capacity; i++) {
+                const HandleIdEntry* entry = &table->id_map[i];
+                if (entry->id != 0) {
+                    new_map[id_map_find(new_map, (int)map_capacity, entry->id)] = *entry;
+                }
+            }
+            released += ((size_t)table->id_map_capacity - map_capacity) * sizeof(HandleIdEntry);
+            free(table->id_map);
+            table->id_map = new_map;
+            table->id_map_capacity = (int)map_capacity;
+        }
+    }
+
+    return released;
+}
+
+bool handle_table_reserve(HandleTable* table, int count) {
+    if (!table || count < 0) return false;
+
+    // Free slots are not counted, so this may reserve a little more than needed
+    return ensure_id_map_room(table, count) && ensure_slot_room(table, count);
+}
+
+int handle_table_acquire(HandleTable* table, int id, int parent_slot, int array_index) {
+    if (!table || id <= 0) return HANDLE_INVALID_INDEX;
+
+    // Re-registering an ID just updates its location
+    int existing = handle_table_slot_of(table, id);
+    if (existing != HANDLE_INVALID_INDEX) {
+        table->slots[existing].parent_slot = parent_slot;
+        table->slots[existing].array_index = array_index;
+        return existing;
+    }
+
+    if (!ensure_id_map_room(table, 1)) {
+        return HANDLE_INVALID_INDEX;
+    }
+
+    int index;
+    if (table->free_head != HANDLE_INVALID_INDEX) {
+        index = table->free_head;
+        table->free_head = table->slots[index].next_free;
+    } else {
+        if (!ensure_slot_room(table, 1)) {
+            return HANDLE_INVALID_INDEX;
+        }
+
+        index = table->slot_count++;
+        table->slots[index].generation = 1;
+    }
+
+    HandleSlot* slot = &table->slots[index];
+    slot->id = id;
+    slot->parent_slot = parent_slot;
+    slot->array_index = array_index;
+    slot->next_free = HANDLE_INVALID_INDEX;
+
+    HandleIdEntry* entry = &table->id_map[id_map_find(table->id_map, table->id_map_capacity, id)];
+    entry->id = id;
+    entry->slot = index;
+    table->id_map_count++;
+    return index;
+}
+
+void handle_table_release(HandleTable* table, int id) {
+    int index = handle_table_slot_of(table, id);
+    if (index == HANDLE_INVALID_INDEX) return;
+
+    HandleSlot* slot = &table->slots[index];
+    slot->generation++;
+    slot->id = 0;
+    slot->next_free = table->free_head;
+    table->free_head = index;
+
+    id_map_erase(table, id_map_find(table->id_map, table->id_map_capacity, id));
+}
+
+void handle_table_move(HandleTable* table, int id, int array_index) {
+    int index = handle_table_slot_of(table, id);
+    if (index == HANDLE_INVALID_INDEX) return;
+
+    table->slots[index].array_index = array_index;
+}
+
+int handle_table_slot_of(const HandleTable* table, int id) {
+    if (!table || id <= 0 || table->id_map_count == 0) {
+        return HANDLE_INVALID_INDEX;
+    }
+
+    const HandleIdEntry* entry = &table->id_map[id_map_find(table->id_map, table->id_map_capacity, id)];
+    return entry->id == id ? entry->slot : HANDLE_INVALID_INDEX;
+}
+
+const HandleSlot* handle_table_lookup(const HandleTable* table, int index, unsigned int generation) {
+    if (!table || index < 0 || index >= table->slot_count) {
+        return NULL;
+    }
+
+    const HandleSlot* slot = &table->slots[index];
+    if (slot->id == 0 || slot->generation != generation) {
+        return NULL;
+    }
+
+    return slot;
+}
@@ -10,15 +10,22 @@
 #include "../include/category.h"
 #include "../include/subgroup.h"
 #include "../include/product.h"
+#include "../include/command.h"
+#include "../include/render.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <ctype.h>
+
+#ifdef _WIN32
 #include <windows.h>
+#endif
 
 #define DATA_FILE "data/products.dat"
 
 // Forward declarations
 void display_main_menu(void);
+void view_all_data(DataStore* store);
 void category_management_menu(DataStore* store);
 void subgroup_management_menu(DataStore* store);
 void product_management_menu(DataStore* store);
@@ -51,7 +58,13 @@ void search_by_quantity(DataStore* store);
 // Statistics functions
 void display_statistics(DataStore* store);
 
-int main(void) {
+int main(int argc, char* argv[]) {
+    // Any arguments select the non-interactive command mode
+    if (argc > 1) {
+        return command_main(argc, argv, DATA_FILE);
+    }
+    
+    #ifdef _WIN32
     // Store original console code pages
     UINT originalInputCP = GetConsoleCP();
     UINT originalOutputCP = GetConsoleOutputCP();
@@ -59,6 +72,7 @@ int main(void) {
     // Set console to UTF-8 mode
     SetConsoleCP(65001);
     SetConsoleOutputCP(65001);
+    #endif
     
     DataStore store = datastore_init();
     
@@ -98,8 +112,7 @@ int main(void) {
                 statistics_menu(&store);
                 break;
             case 6:
-                datastore_display_all(&store);
-                pause_screen();
+                view_all_data(&store);
                 break;
             case 0:
                 if (store.is_modified) {
@@ -122,9 +135,11 @@ int main(void) {
     
     datastore_free(&store);
     
+    #ifdef _WIN32
     // Restore original console code pages
     SetConsoleCP(originalInputCP);
     SetConsoleOutputCP(originalOutputCP);
+    #endif
     
     return 0;
 }
@@ -152,6 +167,79 @@ void display_main_menu(void) {
     printf("\n");
 }
 
+// ============================================================================
+// Paged Views
+// ============================================================================
+
+/**
+ * @brief Show a listing one page at a time until the user goes back
+ * @param store Pointer to DataStore
+ * @param title Heading, at most 58 characters
+ * @param display_page Prints the page the cursor is on
+ *
+ * Enter moves to the next page. The listing is redrawn from the store on
+ * every step, so pages stay consistent with edits made elsewhere.
+ */
+static void browse_pages(DataStore* store, const char* title,
+                         void (*display_page)(DataStore*, PageCursor*)) {
+    PageCursor cursor;
+    page_cursor_init(&cursor, LISTING_PAGE_SIZE);
+    int padding = 58 - (int)strlen(title);
+    if (padding < 0) padding = 0;
+    
+    while (true) {
+        clear_screen();
+        set_color(COLOR_HEADER);
+        printf("\n");
+        printf("  ╔══════════════════════════════════════════════════════════╗\n");
+        printf("  ║%*s%s%*s║\n", padding / 2, "", title, padding - padding / 2, "");
+        printf("  ╚══════════════════════════════════════════════════════════╝\n");
+        set_color(COLOR_RESET);
+        printf("\n");
+        
+        display_page(store, &cursor);
+        
+        printf("  [N]ext  [P]revious  [F]irst  [L]ast  [G]o to page  [0] Back\n");
+        char command[32];
+        if (!safe_input_string("  Enter your choice: ", command, sizeof(command))) {
+            return;
+        }
+        
+        switch (tolower((unsigned char)command[0])) {
+            case '\0':
+            case 'n':
+                page_cursor_move(&cursor, 1);
+                break;
+            case 'p':
+                page_cursor_move(&cursor, -1);
+                break;
+            case 'f':
+                page_cursor_seek(&cursor, 0);
+                break;
+            case 'l':
+                page_cursor_seek(&cursor, page_cursor_page_count(&cursor) - 1);
+                break;
+            case 'g': {
+                int page;
+                if (safe_input_int("  Page number: ", &page)) {
+                    page_cursor_seek(&cursor, page - 1);
+                }
+                break;
+            }
+            case '0':
+            case 'q':
+            case 'b':
+                return;
+            default:
+                break;
+        }
+    }
+}
+
+void view_all_data(DataStore* store) {
+    browse_pages(store, "ALL DATA - HIERARCHICAL VIEW", datastore_display_hierarchy_page);
+}
+
 // ============================================================================
 // Category Management
 // ============================================================================
@@ -243,10 +331,9 @@ void add_category(DataStore* store) {
     }
     set_color(COLOR_RESET);
     
-    Category category = category_create(store->next_category_id, name, description);
+    Category category = category_create(datastore_allocate_id(store, ID_CATEGORY), name, description);
     
     if (datastore_add_category(store, category)) {
-        store->next_category_id++;
         set_color(COLOR_SUCCESS);
         printf("\n  ✓ Category added successfully! (ID: %d)\n", category.id);
         set_color(COLOR_RESET);
@@ -312,7 +399,7 @@ void edit_category(DataStore* store) {
     }
     set_color(COLOR_RESET);
     
-    store->is_modified = true;
+    datastore_mark_modified(store);
     set_color(COLOR_SUCCESS);
     printf("\n  ✓ Category updated successfully!\n");
     set_color(COLOR_RESET);
@@ -411,6 +498,7 @@ void list_categories(DataStore* store) {
     }
     
     printf("  Total Categories: %d\n\n", store->category_count);
+    render_begin();
     category_display_table_header();
     
     for (int i = 0; i < store->category_count; i++) {
@@ -418,6 +506,8 @@ void list_categories(DataStore* store) {
     }
     
     category_display_table_footer();
+    
+    render_end();
     printf("\n");
     pause_screen();
 }
@@ -492,11 +582,13 @@ void add_subgroup(DataStore* store) {
     }
     
     printf("  Available Categories:\n");
+    render_begin();
     category_display_table_header();
     for (int i = 0; i < store->category_count; i++) {
         category_display_table_row(&store->categories[i]);
     }
     category_display_table_footer();
+    render_end();
     printf("\n");
     
     int category_id;
@@ -549,11 +641,9 @@ void add_subgroup(DataStore* store) {
     }
     set_color(COLOR_RESET);
     
-    Subgroup subgroup = subgroup_create(store->next_subgroup_id, category_id, name, description);
+    Subgroup subgroup = subgroup_create(datastore_allocate_id(store, ID_SUBGROUP), category_id, name, description);
     
-    if (category_add_subgroup(category, subgroup)) {
-        store->next_subgroup_id++;
-        store->is_modified = true;
+    if (datastore_add_subgroup(store, category_id, subgroup)) {
         set_color(COLOR_SUCCESS);
         printf("\n  ✓ Subgroup added successfully! (ID: %d)\n", subgroup.id);
         set_color(COLOR_RESET);
@@ -620,7 +710,7 @@ void edit_subgroup(DataStore* store) {
     }
     set_color(COLOR_RESET);
     
-    store->is_modified = true;
+    datastore_mark_modified(store);
     set_color(COLOR_SUCCESS);
     printf("\n  ✓ Subgroup updated successfully!\n");
     set_color(COLOR_RESET);
@@ -657,8 +747,6 @@ void delete_subgroup(DataStore* store) {
         return;
     }
     
-    Category* category = datastore_find_category_by_id(store, subgroup->category_id);
-    
     printf("\n  Subgroup to delete:\n");
     printf("  ┌──────────────────────────────────────────────────────────┐\n");
     printf("  │  ID: %-52d│\n", subgroup->id);
@@ -686,8 +774,7 @@ void delete_subgroup(DataStore* store) {
     set_color(COLOR_RESET);
     
     if (strcmp(confirm, "yes") == 0 || strcmp(confirm, "YES") == 0) {
-        if (category_remove_subgroup(category, id)) {
-            store->is_modified = true;
+        if (datastore_remove_subgroup(store, id)) {
             set_color(COLOR_SUCCESS);
             printf("\n  ✓ Subgroup deleted successfully!\n");
             set_color(COLOR_RESET);
@@ -727,6 +814,7 @@ void list_subgroups(DataStore* store) {
     }
     
     printf("  Total Subgroups: %d\n\n", total);
+    render_begin();
     subgroup_display_table_header();
     
     for (int i = 0; i < store->category_count; i++) {
@@ -736,6 +824,8 @@ void list_subgroups(DataStore* store) {
     }
     
     subgroup_display_table_footer();
+    
+    render_end();
     printf("\n");
     pause_screen();
 }
@@ -816,6 +906,7 @@ void add_product(DataStore* store) {
     }
     
     printf("  Available Subgroups:\n");
+    render_begin();
     subgroup_display_table_header();
     for (int i = 0; i < store->category_count; i++) {
         for (int j = 0; j < store->categories[i].subgroup_count; j++) {
@@ -823,6 +914,7 @@ void add_product(DataStore* store) {
         }
     }
     subgroup_display_table_footer();
+    render_end();
     printf("\n");
     
     int subgroup_id;
@@ -898,11 +990,9 @@ void add_product(DataStore* store) {
     
     get_current_timestamp(timestamp, sizeof(timestamp));
     
-    Product product = product_create(store->next_product_id, subgroup_id, code, name, description, price, quantity);
+    Product product = product_create(datastore_allocate_id(store, ID_PRODUCT), subgroup_id, code, name, description, price, quantity);
     
-    if (subgroup_add_product(subgroup, product)) {
-        store->next_product_id++;
-        store->is_modified = true;
+    if (datastore_add_product(store, subgroup_id, product)) {
         set_color(COLOR_SUCCESS);
         printf("\n  ✓ Product added successfully! (ID: %d)\n", product.id);
         set_color(COLOR_RESET);
@@ -950,36 +1040,43 @@ void edit_product(DataStore* store) {
     
     printf("\n  Enter new values (press Enter to keep current):\n\n");
     
+    Product updated = *product;
     char buffer[200];
     float price;
     int quantity;
     
     set_color(COLOR_INPUT);
     if (safe_input_string("  New Code: ", buffer, sizeof(buffer)) && strlen(buffer) > 0) {
-        product_update_code(product, buffer);
+        product_update_code(&updated, buffer);
     }
     
     if (safe_input_string("  New Name: ", buffer, sizeof(buffer)) && strlen(buffer) > 0) {
-        product_update_name(product, buffer);
+        product_update_name(&updated, buffer);
     }
     
     if (safe_input_string("  New Description: ", buffer, sizeof(buffer))) {
-        product_update_description(product, buffer);
+        product_update_description(&updated, buffer);
     }
     
-    printf("  New Price (current: %.2f, press Enter to skip): ", product->price);
+    printf("  New Price (current: %.2f, press Enter to skip): ", updated.price);
     if (safe_input_float("", &price) && price >= 0) {
-        product_update_price(product, price);
+        product_update_price(&updated, price);
     }
     
-    printf("  New Quantity (current: %d, press Enter to skip): ", product->quantity);
+    printf("  New Quantity (current: %d, press Enter to skip): ", updated.quantity);
     if (safe_input_int("", &quantity) && quantity >= 0) {
-        product_update_quantity(product, quantity);
+        product_update_quantity(&updated, quantity);
     }
     set_color(COLOR_RESET);
     
-    product_update_timestamp(product);
-    store->is_modified = true;
+    if (!datastore_update_product(store, updated)) {
+        set_color(COLOR_ERROR);
+        printf("\n  ✗ Failed to update product.\n");
+        set_color(COLOR_RESET);
+        pause_screen();
+        return;
+    }
+    
     set_color(COLOR_SUCCESS);
     printf("\n  ✓ Product updated successfully!\n");
     set_color(COLOR_RESET);
@@ -1031,9 +1128,7 @@ void delete_product(DataStore* store) {
     set_color(COLOR_RESET);
     
     if (strcmp(confirm, "yes") == 0 || strcmp(confirm, "YES") == 0) {
-        Subgroup* subgroup = datastore_find_subgroup_by_id(store, product->subgroup_id);
-        if (subgroup && subgroup_remove_product(subgroup, id)) {
-            store->is_modified = true;
+        if (datastore_remove_product(store, id)) {
             set_color(COLOR_SUCCESS);
             printf("\n  ✓ Product deleted successfully!\n");
             set_color(COLOR_RESET);
@@ -1052,37 +1147,7 @@ void delete_product(DataStore* store) {
 }
 
 void list_products(DataStore* store) {
-    clear_screen();
-    set_color(COLOR_HEADER);
-    printf("\n");
-    printf("  ╔══════════════════════════════════════════════════════════╗\n");
-    printf("  ║                       ALL PRODUCTS                       ║\n");
-    printf("  ╚══════════════════════════════════════════════════════════╝\n");
-    set_color(COLOR_RESET);
-    printf("\n");
-    
-    Statistics stats = datastore_get_statistics(store);
-    
-    if (stats.total_products == 0) {
-        printf("  No products found.\n\n");
-        pause_screen();
-        return;
-    }
-    
-    printf("  Total Products: %d\n\n", stats.total_products);
-    product_display_table_header();
-    
-    for (int i = 0; i < store->category_count; i++) {
-        for (int j = 0; j < store->categories[i].subgroup_count; j++) {
-            for (int k = 0; k < store->categories[i].subgroups[j].product_count; k++) {
-                product_display_table_row(&store->categories[i].subgroups[j].products[k]);
-            }
-        }
-    }
-    
-    product_display_table_footer();
-    printf("\n");
-    pause_screen();
+    browse_pages(store, "ALL PRODUCTS", datastore_display_products_page);
 }
 
 // ============================================================================
@@ -1160,11 +1225,13 @@ void search_by_name(DataStore* store) {
     printf("\n  Search Results: %d product(s) found\n\n", result.count);
     
     if (result.count > 0) {
+        render_begin();
         product_display_table_header();
         for (int i = 0; i < result.count; i++) {
             product_display_table_row(&result.products[i]);
         }
         product_display_table_footer();
+        render_end();
     }
     
     search_result_free(&result);
@@ -1206,11 +1273,13 @@ void search_by_price(DataStore* store) {
     printf("\n  Search Results: %d product(s) found\n\n", result.count);
     
     if (result.count > 0) {
+        render_begin();
         product_display_table_header();
         for (int i = 0; i < result.count; i++) {
             product_display_table_row(&result.products[i]);
         }
         product_display_table_footer();
+        render_end();
     }
     
     search_result_free(&result);
@@ -1252,11 +1321,13 @@ void search_by_quantity(DataStore* store) {
     printf("\n  Search Results: %d product(s) found\n\n", result.count);
     
     if (result.count > 0) {
+        render_begin();
         product_display_table_header();
         for (int i = 0; i < result.count; i++) {
             product_display_table_row(&result.products[i]);
         }
         product_display_table_footer();
+        render_end();
     }
     
     search_result_free(&result);
@@ -1291,5 +1362,9 @@ void statistics_menu(DataStore* store) {
     printf("  └──────────────────────────────────────────────────────────┘\n");
     printf("\n");
     
+    printf("  MEMORY USAGE\n");
+    datastore_display_memory(store);
+    printf("\n");
+    
     pause_screen();
 }
\ No newline at end of file
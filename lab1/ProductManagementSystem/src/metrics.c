@@ -0,0 +1,290 @@
+/**
+ * @file metrics.c
+ * @brief Per-operation call counters and latency histograms implementation
+ * @author PMS Team
+ * @date 2025
+ * @compatible Dev-C++ 6.3, TDM-GCC 9.2.0, C11
+ */
+
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L    // clock_gettime under -std=c11
+#endif
+
+#include "../include/metrics.h"
+#include <string.h>
+#include <time.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+#define SUB_BUCKETS (1 << METRICS_SUB_BUCKET_BITS)
+#define MAX_VALUE ((1ULL << METRICS_MAX_EXPONENT) - 1)
+
+typedef struct {
+    atomic_ullong count;
+    atomic_ullong failures;
+    atomic_ullong total_ns;
+    atomic_ullong min_ns;      // Value + 1, 0 until the first call
+    atomic_ullong max_ns;      // Value + 1
+    atomic_ullong buckets[METRICS_BUCKET_COUNT];
+} Metric;
+
+atomic_bool metrics_active = false;
+
+static Metric metrics[METRIC_COUNT];
+
+static const char* const METRIC_NAMES[METRIC_COUNT] = {
+    "datastore_add_category",
+    "datastore_add_subgroup",
+    "datastore_add_product",
+    "datastore_remove_category",
+    "datastore_remove_subgroup",
+    "datastore_remove_product",
+    "datastore_update_product",
+    "datastore_find_category_by_id",
+    "datastore_find_subgroup_by_id",
+    "datastore_find_product_by_id",
+    "datastore_search_products_by_name",
+    "datastore_search_products_by_price",
+    "datastore_search_products_by_quantity",
+    "datastore_get_statistics",
+    "datastore_batch_add",
+    "datastore_batch_update",
+    "datastore_batch_remove",
+    "datastore_batch_commit",
+    "datastore_txn_add_category",
+    "datastore_txn_remove_category",
+    "datastore_txn_add_subgroup",
+    "datastore_txn_remove_subgroup",
+    "datastore_txn_add_product",
+    "datastore_txn_remove_product",
+    "datastore_txn_update_product",
+    "datastore_txn_move_product",
+    "datastore_txn_commit",
+    "datastore_txn_abort",
+    "datastore_mark_modified",
+    "datastore_compact",
+    "datastore_save",
+    "datastore_load",
+    "category_add_subgroup",
+    "category_remove_subgroup",
+    "category_find_subgroup_by_id",
+    "category_update_name",
+    "category_update_description",
+    "subgroup_add_product",
+    "subgroup_remove_product",
+    "subgroup_find_product_by_id",
+    "subgroup_update_name",
+    "subgroup_update_description",
+    "product_update_code",
+    "product_update_name",
+    "product_update_description",
+    "product_update_price",
+    "product_update_quantity"
+};
+
+// ============================================================================
+// Clock
+// ============================================================================
+
+unsigned long long metrics_now_ns(void) {
+    unsigned long long ns;
+#ifdef _WIN32
+    static LARGE_INTEGER frequency;
+    LARGE_INTEGER counter;
+    if (frequency.QuadPart == 0) QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    ns = (unsigned long long)(counter.QuadPart / frequency.QuadPart) * 1000000000ULL +
+         (unsigned long long)(counter.QuadPart % frequency.QuadPart) * 1000000000ULL /
+         (unsigned long long)frequency.QuadPart;
+#else
+    struct timespec ts;
+    #ifdef CLOCK_MONOTONIC
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    #else
+    timespec_get(&ts, TIME_UTC);
+    #endif
+    ns = (unsigned long long)ts.tv_sec * 1000000000ULL + (unsigned long long)ts.tv_nsec;
+#endif
+    return ns ? ns : 1;        // 0 means "not timed" to METRICS_STOP
+}
+
+// ============================================================================
+// Histogram Buckets
+// ============================================================================
+
+static int highest_bit(unsigned long long value) {
+#if defined(__GNUC__)
+    return 63 - __builtin_clzll(value);
+#else
+    int bit = 0;
+    while (value >>= 1) bit++;
+    return bit;
+#endif
+}
+
+/**
+ * @brief Bucket of a value: exact below 2 * SUB_BUCKETS, then SUB_BUCKETS per power of two
+ */
+static int bucket_index(unsigned long long value) {
+    if (value > MAX_VALUE) value = MAX_VALUE;
+    if (value < SUB_BUCKETS) return (int)value;
+
+    int shift = highest_bit(value) - METRICS_SUB_BUCKET_BITS;
+    return (shift << METRICS_SUB_BUCKET_BITS) + (int)(value >> shift);
+}
+
+/**
+ * @brief Largest value that lands in a bucket
+ */
+static unsigned long long bucket_upper(int index) {
+    if (index < 2 * SUB_BUCKETS) return (unsigned long long)index;
+
+    int shift = (index >> METRICS_SUB_BUCKET_BITS) - 1;
+    unsigned long long mantissa = (unsigned long long)(index - (shift << METRICS_SUB_BUCKET_BITS));
+    return ((mantissa + 1) << shift) - 1;
+}
+
+// ============================================================================
+// Recording
+// ============================================================================
+
+void metrics_set_enabled(bool enabled) {
+    atomic_store(&metrics_active, enabled);
+}
+
+bool metrics_enabled(void) {
+    return atomic_load(&metrics_active);
+}
+
+void metrics_reset(void) {
+    for (int i = 0; i < METRIC_COUNT; i++) {
+        Metric* metric = &metrics[i];
+        atomic_store_explicit(&metric->count, 0, memory_order_relaxed);
+        atomic_store_explicit(&metric->failures, 0, memory_order_relaxed);
+        atomic_store_explicit(&metric->total_ns, 0, memory_order_relaxed);
+        atomic_store_explicit(&metric->min_ns, 0, memory_order_relaxed);
+        atomic_store_explicit(&metric->max_ns, 0, memory_order_relaxed);
+        for (int b = 0; b < METRICS_BUCKET_COUNT; b++) {
+            atomic_store_explicit(&metric->buckets[b], 0, memory_order_relaxed);
+        }
+    }
+}
+
+void metrics_record(MetricId id, unsigned long long elapsed_ns, bool ok) {
+    if ((unsigned)id >= METRIC_COUNT) return;
+    Metric* metric = &metrics[id];
+
+    atomic_fetch_add_explicit(&metric->count, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&metric->total_ns, elapsed_ns, memory_order_relaxed);
+    atomic_fetch_add_explicit(&metric->buckets[bucket_index(elapsed_ns)], 1, memory_order_relaxed);
+    if (!ok) {
+        atomic_fetch_add_explicit(&metric->failures, 1, memory_order_relaxed);
+    }
+
+    // Stored as value + 1 so that 0 means no value yet
+    unsigned long long stored = elapsed_ns + 1;
+    unsigned long long current = atomic_load_explicit(&metric->min_ns, memory_order_relaxed);
+    while ((current == 0 || stored < current) &&
+           !atomic_compare_exchange_weak_explicit(&metric->min_ns, &current, stored,
+                                                  memory_order_relaxed, memory_order_relaxed)) {
+    }
+
+    current = atomic_load_explicit(&metric->max_ns, memory_order_relaxed);
+    while (stored > current &&
+           !atomic_compare_exchange_weak_explicit(&metric->max_ns, &current, stored,
+                                                  memory_order_relaxed, memory_order_relaxed)) {
+    }
+}
+
+// ============================================================================
+// Reporting
+// ============================================================================
+
+const char* metrics_name(MetricId id) {
+    return (unsigned)id < METRIC_COUNT ? METRIC_NAMES[id] : "unknown";
+}
+
+MetricSummary metrics_summary(MetricId id) {
+    MetricSummary summary;
+    memset(&summary, 0, sizeof(summary));
+    if ((unsigned)id >= METRIC_COUNT) return summary;
+
+    Metric* metric = &metrics[id];
+    unsigned long long min_stored = atomic_load_explicit(&metric->min_ns, memory_order_relaxed);
+    unsigned long long max_stored = atomic_load_explicit(&metric->max_ns, memory_order_relaxed);
+    summary.failures = atomic_load_explicit(&metric->failures, memory_order_relaxed);
+    summary.total_ns = atomic_load_explicit(&metric->total_ns, memory_order_relaxed);
+    summary.min_ns = min_stored ? min_stored - 1 : 0;
+    summary.max_ns = max_stored ? max_stored - 1 : 0;
+
+    // Percentiles come from a copy so concurrent calls cannot skew the ranks
+    unsigned long long counts[METRICS_BUCKET_COUNT];
+    unsigned long long total = 0;
+    for (int b = 0; b < METRICS_BUCKET_COUNT; b++) {
+        counts[b] = atomic_load_explicit(&metric->buckets[b], memory_order_relaxed);
+        total += counts[b];
+    }
+    summary.count = total;
+    if (total == 0) return summary;
+
+    // Rank of each percentile: the smallest n with n >= q * total
+    const unsigned long long per_mille[4] = { 500, 900, 990, 999 };
+    unsigned long long* outputs[4] = { &summary.p50_ns, &summary.p90_ns, &summary.p99_ns, &summary.p999_ns };
+    unsigned long long ranks[4];
+    for (int q = 0; q < 4; q++) {
+        ranks[q] = (total * per_mille[q] + 999) / 1000;
+    }
+
+    unsigned long long seen = 0;
+    int q = 0;
+    for (int b = 0; b < METRICS_BUCKET_COUNT && q < 4; b++) {
+        seen += counts[b];
+        while (q < 4 && seen >= ranks[q]) {
+            unsigned long long value = bucket_upper(b);
+            *outputs[q++] = value < summary.max_ns ? value : summary.max_ns;
+        }
+    }
+    return summary;
+}
+
+int metrics_dump(FILE* out, MetricsFormat format) {
+    int lines = 0;
+
+    if (format == METRICS_JSON) {
+        fprintf(out, "{\"enabled\":%s,\"unit\":\"ns\",\"operations\":[\n", metrics_enabled() ? "true" : "false");
+        lines++;
+    } else {
+        fprintf(out, "%-38s %10s %8s %10s %10s %10s %10s %10s %12s\n",
+                "operation", "calls", "failed", "mean", "p50", "p90", "p99", "p99.9", "max");
+        lines++;
+    }
+
+    bool first = true;
+    for (int i = 0; i < METRIC_COUNT; i++) {
+        MetricSummary s = metrics_summary((MetricId)i);
+        if (s.count == 0) continue;
+        unsigned long long mean = s.total_ns / s.count;
+
+        if (format == METRICS_JSON) {
+            fprintf(out, "%s{\"name\":\"%s\",\"count\":%llu,\"failures\":%llu,\"total\":%llu,"
+                         "\"min\":%llu,\"mean\":%llu,\"p50\":%llu,\"p90\":%llu,\"p99\":%llu,"
+                         "\"p999\":%llu,\"max\":%llu}",
+                    first ? "" : ",\n", METRIC_NAMES[i], s.count, s.failures, s.total_ns,
+                    s.min_ns, mean, s.p50_ns, s.p90_ns, s.p99_ns, s.p999_ns, s.max_ns);
+        } else {
+            fprintf(out, "%-38s %10llu %8llu %10llu %10llu %10llu %10llu %10llu %12llu\n",
+                    METRIC_NAMES[i], s.count, s.failures, mean,
+                    s.p50_ns, s.p90_ns, s.p99_ns, s.p999_ns, s.max_ns);
+        }
+        first = false;
+        lines++;
+    }
+
+    if (format == METRICS_JSON) {
+        fprintf(out, "%s]}\n", first ? "" : "\n");
+        lines++;
+    }
+    return lines;
+}
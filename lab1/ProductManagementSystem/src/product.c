@@ -7,10 +7,12 @@
  */
 
 #include "../include/product.h"
+#include "../include/metrics.h"
+#include "../include/render.h"
+#include "../include/timestamp.h"
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
-#include <time.h>
 
 /**
  * @brief Trim whitespace from string (helper function)
@@ -37,18 +39,6 @@ static void trim_string(char* str) {
     }
 }
 
-/**
- * @brief Get current timestamp (helper function)
- */
-static void get_current_timestamp(char* buffer, size_t size) {
-    if (!buffer || size < 20) return;
-    
-    time_t now = time(NULL);
-    struct tm* tm_info = localtime(&now);
-    
-    strftime(buffer, size, "%Y-%m-%d %H:%M:%S", tm_info);
-}
-
 Product product_create(int id, int subgroup_id, const char* code, const char* name, 
                       const char* description, float price, int quantity) {
     Product product;
@@ -74,7 +64,7 @@ Product product_create(int id, int subgroup_id, const char* code, const char* na
     trim_string(product.description);
     
     // Set timestamps
-    get_current_timestamp(product.created_at, sizeof(product.created_at));
+    timestamp_now(product.created_at, sizeof(product.created_at));
     strcpy(product.updated_at, product.created_at);
     
     return product;
@@ -82,30 +72,30 @@ Product product_create(int id, int subgroup_id, const char* code, const char* na
 
 void product_display(const Product* product) {
     if (!product) {
-        printf("Error: Product pointer is NULL\n");
+        render_printf("Error: Product pointer is NULL\n");
         return;
     }
     
-    printf("\n╔══════════════════════════════════════════════════════════╗\n");
-    printf(  "║   Product Information                                    ║\n");
-    printf(  "╚══════════════════════════════════════════════════════════╝\n");
-    printf("  ID:          %d\n", product->id);
-    printf("  Subgroup ID: %d\n", product->subgroup_id);
-    printf("  Code:        %s\n", product->code);
-    printf("  Name:        %s\n", product->name);
-    printf("  Description: %s\n", product->description);
-    printf("  Price:       $%.2f\n", product->price);
-    printf("  Quantity:    %d\n", product->quantity);
-    printf("  Total Value: $%.2f\n", product->price * product->quantity);
-    printf("  Created:     %s\n", product->created_at);
-    printf("  Updated:     %s\n", product->updated_at);
-    printf("\n");
+    render_printf("\n╔══════════════════════════════════════════════════════════╗\n");
+    render_printf(  "║   Product Information                                    ║\n");
+    render_printf(  "╚══════════════════════════════════════════════════════════╝\n");
+    render_printf("  ID:          %d\n", product->id);
+    render_printf("  Subgroup ID: %d\n", product->subgroup_id);
+    render_printf("  Code:        %s\n", product->code);
+    render_printf("  Name:        %s\n", product->name);
+    render_printf("  Description: %s\n", product->description);
+    render_printf("  Price:       $%.2f\n", product->price);
+    render_printf("  Quantity:    %d\n", product->quantity);
+    render_printf("  Total Value: $%.2f\n", product->price * product->quantity);
+    render_printf("  Created:     %s\n", product->created_at);
+    render_printf("  Updated:     %s\n", product->updated_at);
+    render_printf("\n");
 }
 
 void product_display_table_header(void) {
-    printf("  ┌────────┬──────────┬────────────┬──────────────────────┬──────────────┬──────────┐\n");
-    printf("  │   ID   │ Sub ID   │ Code       │ Name                 │    Price     │ Quantity │\n");
-    printf("  ├────────┼──────────┼────────────┼──────────────────────┼──────────────┼──────────┤\n");
+    render_printf("  ┌────────┬──────────┬────────────┬──────────────────────┬──────────────┬──────────┐\n");
+    render_printf("  │   ID   │ Sub ID   │ Code       │ Name                 │    Price     │ Quantity │\n");
+    render_printf("  ├────────┼──────────┼────────────┼──────────────────────┼──────────────┼──────────┤\n");
 }
 
 void product_display_table_row(const Product* product) {
@@ -122,20 +112,20 @@ void product_display_table_row(const Product* product) {
         display_name[20] = '\0';
     }
     
-    printf("  │ %-6d │ %-8d │ %-10s │ %-20s │ $%11.2f │ %-8d │\n",
-           product->id,
-           product->subgroup_id,
-           product->code,
-           display_name,
-           product->price,
-           product->quantity);
+    render_printf("  │ %-6d │ %-8d │ %-10s │ %-20s │ $%11.2f │ %-8d │\n",
+                  product->id,
+                  product->subgroup_id,
+                  product->code,
+                  display_name,
+                  product->price,
+                  product->quantity);
 }
 
 void product_display_table_footer(void) {
-    printf("  └────────┴──────────┴────────────┴──────────────────────┴──────────────┴──────────┘\n");
+    render_printf("  └────────┴──────────┴────────────┴──────────────────────┴──────────────┴──────────┘\n");
 }
 
-bool product_update_code(Product* product, const char* code) {
+static bool update_code(Product* product, const char* code) {
     if (!product) {
         fprintf(stderr, "Error: Product pointer is NULL\n");
         return false;
@@ -159,7 +149,14 @@ bool product_update_code(Product* product, const char* code) {
     return true;
 }
 
-bool product_update_name(Product* product, const char* name) {
+bool product_update_code(Product* product, const char* code) {
+    MetricTimer timer = METRICS_START();
+    bool ok = update_code(product, code);
+    METRICS_STOP(METRIC_PRODUCT_UPDATE_CODE, timer, ok);
+    return ok;
+}
+
+static bool update_name(Product* product, const char* name) {
     if (!product) {
         fprintf(stderr, "Error: Product pointer is NULL\n");
         return false;
@@ -183,7 +180,14 @@ bool product_update_name(Product* product, const char* name) {
     return true;
 }
 
-bool product_update_description(Product* product, const char* description) {
+bool product_update_name(Product* product, const char* name) {
+    MetricTimer timer = METRICS_START();
+    bool ok = update_name(product, name);
+    METRICS_STOP(METRIC_PRODUCT_UPDATE_NAME, timer, ok);
+    return ok;
+}
+
+static bool update_description(Product* product, const char* description) {
     if (!product) {
         fprintf(stderr, "Error: Product pointer is NULL\n");
         return false;
@@ -201,7 +205,14 @@ bool product_update_description(Product* product, const char* description) {
     return true;
 }
 
-bool product_update_price(Product* product, float price) {
+bool product_update_description(Product* product, const char* description) {
+    MetricTimer timer = METRICS_START();
+    bool ok = update_description(product, description);
+    METRICS_STOP(METRIC_PRODUCT_UPDATE_DESCRIPTION, timer, ok);
+    return ok;
+}
+
+static bool update_price(Product* product, float price) {
     if (!product) {
         fprintf(stderr, "Error: Product pointer is NULL\n");
         return false;
@@ -217,7 +228,14 @@ bool product_update_price(Product* product, float price) {
     return true;
 }
 
-bool product_update_quantity(Product* product, int quantity) {
+bool product_update_price(Product* product, float price) {
+    MetricTimer timer = METRICS_START();
+    bool ok = update_price(product, price);
+    METRICS_STOP(METRIC_PRODUCT_UPDATE_PRICE, timer, ok);
+    return ok;
+}
+
+static bool update_quantity(Product* product, int quantity) {
     if (!product) {
         fprintf(stderr, "Error: Product pointer is NULL\n");
         return false;
@@ -233,10 +251,29 @@ bool product_update_quantity(Product* product, int quantity) {
     return true;
 }
 
+bool product_update_quantity(Product* product, int quantity) {
+    MetricTimer timer = METRICS_START();
+    bool ok = update_quantity(product, quantity);
+    METRICS_STOP(METRIC_PRODUCT_UPDATE_QUANTITY, timer, ok);
+    return ok;
+}
+
+void product_fold_name(const char* name, char* folded) {
+    if (!name || !folded) return;
+    
+    // Zero-fill the tail so the whole field is defined for block compares
+    int i = 0;
+    for (; i < PRODUCT_NAME_SIZE && name[i]; i++) {
+        char c = name[i];
+        folded[i] = (c >= 'A' && c <= 'Z') ? (char)(c + ('a' - 'A')) : c;
+    }
+    memset(folded + i, 0, PRODUCT_NAME_SIZE - i);
+}
+
 void product_update_timestamp(Product* product) {
     if (!product) return;
     
-    get_current_timestamp(product->updated_at, sizeof(product->updated_at));
+    timestamp_now(product->updated_at, sizeof(product->updated_at));
 }
 
 bool product_is_valid(const Product* product) {
@@ -0,0 +1,212 @@
+/**
+ * @file product_table.c
+ * @brief Product scan column table implementation
+ * @author PMS Team
+ * @date 2025
+ * @compatible Dev-C++ 6.3, TDM-GCC 9.2.0, C11
+ */
+
+#include "../include/product_table.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+#define INITIAL_TABLE_CAPACITY 64
+
+void product_table_init(ProductTable* table) {
+    if (!table) return;
+
+    table->slots = NULL;
+    table->prices = NULL;
+    table->quantities = NULL;
+    table->names_folded = NULL;
+    table->product_count = 0;
+    table->product_capacity = 0;
+    table->row_of_slot = NULL;
+    table->slot_capacity = 0;
+    table->is_built = false;
+}
+
+void product_table_free(ProductTable* table) {
+    if (!table) return;
+
+    free(table->slots);
+    free(table->prices);
+    free(table->quantities);
+    free(table->names_folded);
+    free(table->row_of_slot);
+    product_table_init(table);
+}
+
+/**
+ * @brief Grow a capacity by doubling until it holds needed elements
+ */
+static int grown_capacity(int current, int needed) {
+    int capacity = current > 0 ? current : INITIAL_TABLE_CAPACITY;
+    while (capacity < needed) {
+        capacity *= 2;
+    }
+    return capacity;
+}
+
+/**
+ * @brief Make every column hold at least rows entries
+ */
+static bool reserve_rows(ProductTable* table, int rows) {
+    if (rows <= table->product_capacity) return true;
+
+    int new_capacity = grown_capacity(table->product_capacity, rows);
+
+    int* new_slots = (int*)realloc(table->slots, new_capacity * sizeof(int));
+    if (!new_slots) {
+        fprintf(stderr, "Error: Failed to expand product table\n");
+        return false;
+    }
+    table->slots = new_slots;
+
+    float* new_prices = (float*)realloc(table->prices, new_capacity * sizeof(float));
+    if (!new_prices) {
+        fprintf(stderr, "Error: Failed to expand price column\n");
+        return false;
+    }
+    table->prices = new_prices;
+
+    int* new_quantities = (int*)realloc(table->quantities, new_capacity * sizeof(int));
+    if (!new_quantities) {
+        fprintf(stderr, "Error: Failed to expand quantity column\n");
+        return false;
+    }
+    table->quantities = new_quantities;
+
+    char* new_names = (char*)realloc(table->names_folded, (size_t)new_capacity * PRODUCT_NAME_SIZE);
+    if (!new_names) {
+        fprintf(stderr, "Error: Failed to expand name column\n");
+        return false;
+    }
+    table->names_folded = new_names;
+
+    table->product_capacity = new_capacity;
+    return true;
+}
+
+/**
+ * @brief Make the slot -> row index cover slots [0, slots)
+ */
+static bool reserve_slots(ProductTable* table, int slots) {
+    if (slots <= table->slot_capacity) return true;
+
+    int new_capacity = grown_capacity(table->slot_capacity, slots);
+    int* new_rows = (int*)realloc(table->row_of_slot, new_capacity * sizeof(int));
+    if (!new_rows) {
+        fprintf(stderr, "Error: Failed to expand product table index\n");
+        return false;
+    }
+
+    for (int i = table->slot_capacity; i < new_capacity; i++) {
+        new_rows[i] = -1;
+    }
+    table->row_of_slot = new_rows;
+    table->slot_capacity = new_capacity;
+    return true;
+}
+
+/**
+ * @brief Copy the scanned fields of a product into a row
+ */
+static void write_row(ProductTable* table, int row, const Product* product) {
+    table->prices[row] = product->price;
+    table->quantities[row] = product->quantity;
+    product_fold_name(product->name, table->names_folded + (size_t)row * PRODUCT_NAME_SIZE);
+}
+
+bool product_table_rebuild(ProductTable* table, const HandleTable* handles,
+                           const Category* categories, int category_count) {
+    if (!table || !handles) {
+        fprintf(stderr, "Error: ProductTable pointer is NULL\n");
+        return false;
+    }
+
+    table->is_built = false;
+
+    // Size every column once
+    int total_products = 0;
+    for (int i = 0; i < category_count; i++) {
+        for (int j = 0; j < categories[i].subgroup_count; j++) {
+            total_products += categories[i].subgroups[j].product_count;
+        }
+    }
+
+    if (!reserve_rows(table, total_products) || !reserve_slots(table, handles->slot_count)) {
+        return false;
+    }
+
+    for (int i = 0; i < table->slot_capacity; i++) {
+        table->row_of_slot[i] = -1;
+    }
+
+    int row = 0;
+    for (int i = 0; i < category_count; i++) {
+        for (int j = 0; j < categories[i].subgroup_count; j++) {
+            const Subgroup* sub = &categories[i].subgroups[j];
+
+            for (int k = 0; k < sub->product_count; k++) {
+                int slot = handle_table_slot_of(handles, sub->products[k].id);
+                if (slot == HANDLE_INVALID_INDEX) {
+                    fprintf(stderr, "Error: Product ID %d has no handle\n", sub->products[k].id);
+                    return false;
+                }
+
+                table->slots[row] = slot;
+                table->row_of_slot[slot] = row;
+                write_row(table, row, &sub->products[k]);
+                row++;
+            }
+        }
+    }
+
+    table->product_count = total_products;
+    table->is_built = true;
+    return true;
+}
+
+bool product_table_insert(ProductTable* table, int slot, const Product* product) {
+    if (!table || !table->is_built || slot < 0) return true;
+
+    if (!reserve_rows(table, table->product_count + 1) || !reserve_slots(table, slot + 1)) {
+        table->is_built = false;
+        return false;
+    }
+
+    int row = table->product_count++;
+    table->slots[row] = slot;
+    table->row_of_slot[slot] = row;
+    write_row(table, row, product);
+    return true;
+}
+
+void product_table_update(ProductTable* table, int slot, const Product* product) {
+    if (!table || !table->is_built || slot < 0 || slot >= table->slot_capacity) return;
+
+    int row = table->row_of_slot[slot];
+    if (row >= 0) {
+        write_row(table, row, product);
+    }
+}
+
+void product_table_remove(ProductTable* table, int slot) {
+    if (!table || !table->is_built || slot < 0 || slot >= table->slot_capacity) return;
+
+    int row = table->row_of_slot[slot];
+    if (row < 0) return;
+
+    int last = --table->product_count;
+    if (row < last) {
+        table->slots[row] = table->slots[last];
+        table->prices[row] = table->prices[last];
+        table->quantities[row] = table->quantities[last];
+        memcpy(table->names_folded + (size_t)row * PRODUCT_NAME_SIZE,
+               table->names_folded + (size_t)last * PRODUCT_NAME_SIZE, PRODUCT_NAME_SIZE);
+        table->row_of_slot[table->slots[row]] = row;
+    }
+    table->row_of_slot[slot] = -1;
+}
@@ -0,0 +1,161 @@
+/**
+ * @file render.c
+ * @brief Buffered console output implementation
+ * @author PMS Team
+ * @date 2025
+ * @compatible Dev-C++ 6.3, TDM-GCC 9.2.0, C11
+ */
+
+#include "../include/render.h"
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#ifndef ENABLE_VIRTUAL_TERMINAL_PROCESSING
+#define ENABLE_VIRTUAL_TERMINAL_PROCESSING 0x0004    // Missing from older MinGW headers
+#endif
+#endif
+
+static char buffer[RENDER_BUFFER_SIZE];
+static size_t length = 0;
+static int depth = 0;
+
+// ============================================================================
+// Render Blocks
+// ============================================================================
+
+void render_begin(void) {
+    depth++;
+}
+
+void render_end(void) {
+    if (depth == 0) return;
+    if (--depth == 0) {
+        render_flush();
+    }
+}
+
+bool render_active(void) {
+    return depth > 0;
+}
+
+void render_flush(void) {
+    if (length > 0) {
+        fwrite(buffer, 1, length, stdout);
+        length = 0;
+    }
+    fflush(stdout);
+}
+
+// ============================================================================
+// Output
+// ============================================================================
+
+void render_write(const char* text, size_t count) {
+    if (!text || count == 0) return;
+
+    if (depth == 0) {
+        fwrite(text, 1, count, stdout);
+        return;
+    }
+
+    if (count > RENDER_BUFFER_SIZE - length) {
+        render_flush();
+        if (count >= RENDER_BUFFER_SIZE) {
+            fwrite(text, 1, count, stdout);
+            return;
+        }
+    }
+    memcpy(buffer + length, text, count);
+    length += count;
+}
+
+int render_printf(const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+
+    if (depth == 0) {
+        int written = vprintf(format, args);
+        va_end(args);
+        return written;
+    }
+
+    va_list retry;
+    va_copy(retry, args);
+
+    // Format in place; text that does not fit is simply not counted
+    size_t room = RENDER_BUFFER_SIZE - length;
+    int written = vsnprintf(buffer + length, room, format, args);
+    if (written >= 0 && (size_t)written < room) {
+        length += (size_t)written;
+    } else if (written >= 0) {
+        render_flush();
+        if ((size_t)written < RENDER_BUFFER_SIZE) {
+            vsnprintf(buffer, RENDER_BUFFER_SIZE, format, retry);
+            length = (size_t)written;
+        } else {
+            vprintf(format, retry);
+        }
+    }
+
+    va_end(retry);
+    va_end(args);
+    return written;
+}
+
+// ============================================================================
+// Terminal Capabilities
+// ============================================================================
+
+bool render_ansi_supported(void) {
+    #ifdef _WIN32
+    static int supported = -1;
+    if (supported < 0) {
+        HANDLE console = GetStdHandle(STD_OUTPUT_HANDLE);
+        DWORD mode = 0;
+        supported = GetConsoleMode(console, &mode) &&
+                    SetConsoleMode(console, mode | ENABLE_VIRTUAL_TERMINAL_PROCESSING);
+    }
+    return supported == 1;
+    #else
+    return true;
+    #endif
+}
+
+// ============================================================================
+// Screen Control
+// ============================================================================
+
+#ifdef _WIN32
+/**
+ * @brief Console screen buffer of stdout, false when stdout is redirected
+ */
+static bool console_info(HANDLE* console, CONSOLE_SCREEN_BUFFER_INFO* info) {
+    *console = GetStdHandle(STD_OUTPUT_HANDLE);
+    return *console != INVALID_HANDLE_VALUE && GetConsoleScreenBufferInfo(*console, info);
+}
+#endif
+
+void render_clear_screen(void) {
+    if (render_ansi_supported()) {
+        static const char CLEAR[] = "\033[H\033[2J\033[3J";
+        render_write(CLEAR, sizeof(CLEAR) - 1);
+        return;
+    }
+    #ifdef _WIN32
+    HANDLE console;
+    CONSOLE_SCREEN_BUFFER_INFO info;
+    render_flush();
+    if (!console_info(&console, &info)) return;
+
+    // Blank the whole buffer, as cls does, not just the visible window
+    COORD origin = { 0, 0 };
+    DWORD cells = (DWORD)info.dwSize.X * (DWORD)info.dwSize.Y;
+    DWORD written;
+    FillConsoleOutputCharacterA(console, ' ', cells, origin, &written);
+    FillConsoleOutputAttribute(console, info.wAttributes, cells, origin, &written);
+    SetConsoleCursorPosition(console, origin);
+    #endif
+}
@@ -0,0 +1,628 @@
+/**
+ * @file server.c
+ * @brief Socket query server and client implementation (epoll, Linux)
+ * @author PMS Team
+ * @date 2025
+ * @compatible Dev-C++ 6.3, TDM-GCC 9.2.0, C11
+ */
+
+#include "../include/server.h"
+#include "../include/command.h"
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __linux__
+
+#include <errno.h>
+#include <signal.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+#define INITIAL_BUFFER_CAPACITY 4096
+
+// ============================================================================
+// Byte Buffers
+// ============================================================================
+
+typedef struct {
+    char* data;
+    size_t length;
+    size_t capacity;
+} Buffer;
+
+static bool buffer_reserve(Buffer* buffer, size_t extra) {
+    if (buffer->length + extra <= buffer->capacity) return true;
+
+    size_t new_capacity = buffer->capacity > 0 ? buffer->capacity : INITIAL_BUFFER_CAPACITY;
+    while (new_capacity < buffer->length + extra) {
+        new_capacity *= 2;
+    }
+
+    char* new_data = (char*)realloc(buffer->data, new_capacity);
+    if (!new_data) {
+        fprintf(stderr, "Error: Failed to expand socket buffer\n");
+        return false;
+    }
+
+    buffer->data = new_data;
+    buffer->capacity = new_capacity;
+    return true;
+}
+
+static bool buffer_append(Buffer* buffer, const char* data, size_t length) {
+    if (!buffer_reserve(buffer, length)) return false;
+
+    memcpy(buffer->data + buffer->length, data, length);
+    buffer->length += length;
+    return true;
+}
+
+static void buffer_consume(Buffer* buffer, size_t count) {
+    memmove(buffer->data, buffer->data + count, buffer->length - count);
+    buffer->length -= count;
+}
+
+static void buffer_free(Buffer* buffer) {
+    free(buffer->data);
+    buffer->data = NULL;
+    buffer->length = 0;
+    buffer->capacity = 0;
+}
+
+// ============================================================================
+// Sockets
+// ============================================================================
+
+static bool set_nonblocking(int fd) {
+    int flags = fcntl(fd, F_GETFL, 0);
+    return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+/**
+ * @brief Delete a Unix socket file at path; any other kind of file is left alone
+ */
+static void remove_socket_file(const char* path) {
+    struct stat info;
+    if (lstat(path, &info) == 0 && S_ISSOCK(info.st_mode)) {
+        unlink(path);
+    }
+}
+
+/**
+ * @brief Open a listening or connected socket for a port number or Unix socket path
+ * @return File descriptor, -1 on failure
+ */
+static int open_socket(const char* address, bool listening) {
+    int fd;
+    int result;
+
+    if (strchr(address, '/')) {
+        struct sockaddr_un addr;
+        memset(&addr, 0, sizeof(addr));
+        addr.sun_family = AF_UNIX;
+
+        if (strlen(address) >= sizeof(addr.sun_path)) {
+            fprintf(stderr, "Error: Socket path too long: %s\n", address);
+            return -1;
+        }
+        strcpy(addr.sun_path, address);
+
+        fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0) {
+            fprintf(stderr, "Error: Cannot create socket: %s\n", strerror(errno));
+            return -1;
+        }
+
+        if (listening) {
+            // A leftover socket from an earlier run would make bind fail; a
+            // regular file at the path does too, and is not ours to delete
+            remove_socket_file(address);
+            result = bind(fd, (struct sockaddr*)&addr, sizeof(addr));
+        } else {
+            result = connect(fd, (struct sockaddr*)&addr, sizeof(addr));
+        }
+    } else {
+        char* end;
+        long port = strtol(address, &end, 10);
+        if (end == address || *end != '\0' || port <= 0 || port > 65535) {
+            fprintf(stderr, "Error: Invalid address %s (expected a port or a socket path)\n", address);
+            return -1;
+        }
+
+        struct sockaddr_in addr;
+        memset(&addr, 0, sizeof(addr));
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons((unsigned short)port);
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+        fd = socket(AF_INET, SOCK_STREAM, 0);
+        if (fd < 0) {
+            fprintf(stderr, "Error: Cannot create socket: %s\n", strerror(errno));
+            return -1;
+        }
+
+        if (listening) {
+            int reuse = 1;
+            setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+            result = bind(fd, (struct sockaddr*)&addr, sizeof(addr));
+        } else {
+            result = connect(fd, (struct sockaddr*)&addr, sizeof(addr));
+        }
+    }
+
+    if (result == 0 && listening) {
+        result = listen(fd, SOMAXCONN);
+    }
+
+    if (result != 0) {
+        fprintf(stderr, "Error: Cannot %s %s: %s\n", listening ? "listen on" : "connect to",
+                address, strerror(errno));
+        close(fd);
+        return -1;
+    }
+
+    return fd;
+}
+
+// ============================================================================
+// Server
+// ============================================================================
+
+typedef struct Connection {
+    int fd;
+    Buffer in;                 // Bytes received, not yet a complete request
+    Buffer out;                // Responses not yet sent
+    bool closing;              // Peer finished sending; close once out is drained
+    unsigned int watched;      // epoll event mask currently registered
+    struct Connection* prev;
+    struct Connection* next;
+} Connection;
+
+typedef struct {
+    int epoll_fd;
+    int listen_fd;
+    Connection* connections;
+    CommandContext ctx;
+} Server;
+
+static volatile sig_atomic_t stop_requested = 0;
+
+static void handle_stop_signal(int signal_number) {
+    (void)signal_number;
+    stop_requested = 1;
+}
+
+static void connection_close(Server* server, Connection* conn) {
+    epoll_ctl(server->epoll_fd, EPOLL_CTL_DEL, conn->fd, NULL);
+    close(conn->fd);
+
+    if (conn->prev) conn->prev->next = conn->next;
+    else server->connections = conn->next;
+    if (conn->next) conn->next->prev = conn->prev;
+
+    buffer_free(&conn->in);
+    buffer_free(&conn->out);
+    free(conn);
+}
+
+static void accept_connections(Server* server) {
+    while (true) {
+        int fd = accept(server->listen_fd, NULL, NULL);
+        if (fd < 0) {
+            if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                fprintf(stderr, "Error: accept failed: %s\n", strerror(errno));
+            }
+            return;
+        }
+
+        Connection* conn = (Connection*)calloc(1, sizeof(Connection));
+        if (!conn || !set_nonblocking(fd)) {
+            fprintf(stderr, "Error: Failed to set up connection\n");
+            free(conn);
+            close(fd);
+            continue;
+        }
+        conn->fd = fd;
+        conn->watched = EPOLLIN;
+
+        struct epoll_event event;
+        event.events = EPOLLIN;
+        event.data.ptr = conn;
+        if (epoll_ctl(server->epoll_fd, EPOLL_CTL_ADD, fd, &event) != 0) {
+            fprintf(stderr, "Error: Failed to watch connection: %s\n", strerror(errno));
+            free(conn);
+            close(fd);
+            continue;
+        }
+
+        conn->next = server->connections;
+        if (server->connections) server->connections->prev = conn;
+        server->connections = conn;
+    }
+}
+
+/**
+ * @brief Run one request line and append its framed response
+ */
+static bool handle_request(Server* server, char* line, Buffer* out) {
+    char* result = NULL;
+    size_t size = 0;
+    FILE* stream = open_memstream(&result, &size);
+    if (!stream) {
+        return buffer_append(out, "ERR\n", 4);
+    }
+
+    server->ctx.out = stream;
+    bool ok = command_execute_line(&server->ctx, line);
+    fclose(stream);
+
+    bool appended;
+    if (ok) {
+        int lines = 0;
+        for (size_t i = 0; i < size; i++) {
+            if (result[i] == '\n') lines++;
+        }
+
+        char header[32];
+        int header_length = snprintf(header, sizeof(header), "OK %d\n", lines);
+        appended = buffer_append(out, header, header_length) && buffer_append(out, result, size);
+    } else {
+        appended = buffer_append(out, "ERR\n", 4);
+    }
+
+    free(result);
+    return appended;
+}
+
+/**
+ * @brief Answer every complete request received so far, in order
+ * @return false if the connection must be dropped
+ */
+static bool process_requests(Server* server, Connection* conn) {
+    size_t start = 0;
+
+    while (start < conn->in.length) {
+        char* line = conn->in.data + start;
+        char* newline = (char*)memchr(line, '\n', conn->in.length - start);
+        if (!newline) break;
+
+        *newline = '\0';
+        if (!handle_request(server, line, &conn->out)) return false;
+        start = (size_t)(newline - conn->in.data) + 1;
+    }
+    buffer_consume(&conn->in, start);
+
+    if (conn->in.length >= COMMAND_LINE_SIZE) {
+        fprintf(stderr, "Error: Request too long, dropping client\n");
+        buffer_append(&conn->out, "ERR\n", 4);
+        conn->closing = true;
+        conn->in.length = 0;
+    }
+    return true;
+}
+
+/**
+ * @brief Read everything available, answering complete requests after each chunk
+ * @return false if the connection must be dropped
+ *
+ * Answering as we go means the input buffer never holds more than one
+ * chunk plus a partial line, and an overlong line is rejected as soon as
+ * it passes COMMAND_LINE_SIZE instead of after the peer stops sending.
+ */
+static bool read_requests(Server* server, Connection* conn) {
+    while (!conn->closing) {
+        if (!buffer_reserve(&conn->in, SERVER_READ_CHUNK)) return false;
+
+        ssize_t n = recv(conn->fd, conn->in.data + conn->in.length, SERVER_READ_CHUNK, 0);
+        if (n > 0) {
+            conn->in.length += (size_t)n;
+        } else if (n == 0) {
+            // A final request without '\n' still counts
+            if (conn->in.length > 0 && conn->in.data[conn->in.length - 1] != '\n' &&
+                !buffer_append(&conn->in, "\n", 1)) {
+                return false;
+            }
+            conn->closing = true;
+        } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            return true;
+        } else if (errno == EINTR) {
+            continue;
+        } else {
+            return false;
+        }
+
+        if (!process_requests(server, conn)) return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Send as much pending output as the socket takes
+ * @return false on a socket error
+ */
+static bool write_responses(Connection* conn) {
+    size_t sent = 0;
+
+    while (sent < conn->out.length) {
+        ssize_t n = send(conn->fd, conn->out.data + sent, conn->out.length - sent, MSG_NOSIGNAL);
+        if (n > 0) {
+            sent += (size_t)n;
+        } else if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            break;
+        } else if (n < 0 && errno == EINTR) {
+            continue;
+        } else {
+            return false;
+        }
+    }
+
+    buffer_consume(&conn->out, sent);
+    return true;
+}
+
+static void connection_event(Server* server, Connection* conn, unsigned int events) {
+    bool ok = !(events & EPOLLERR);
+
+    if (ok && (events & (EPOLLIN | EPOLLHUP)) && !conn->closing) {
+        ok = read_requests(server, conn);
+    }
+    if (ok) {
+        ok = write_responses(conn);
+    }
+
+    if (!ok || (conn->closing && conn->out.length == 0)) {
+        connection_close(server, conn);
+        return;
+    }
+
+    // Watch for writability only while responses are backed up, and stop
+    // reading once the peer is done so its EOF does not keep waking us
+    unsigned int watched = (conn->closing ? 0 : EPOLLIN) | (conn->out.length > 0 ? EPOLLOUT : 0);
+    if (watched != conn->watched) {
+        struct epoll_event event;
+        event.events = watched;
+        event.data.ptr = conn;
+        epoll_ctl(server->epoll_fd, EPOLL_CTL_MOD, conn->fd, &event);
+        conn->watched = watched;
+    }
+}
+
+bool server_run(DataStore* store, const char* address, const char* data_file) {
+    if (!store || !address) {
+        fprintf(stderr, "Error: Invalid parameters for server\n");
+        return false;
+    }
+
+    Server server;
+    memset(&server, 0, sizeof(server));
+    server.ctx.store = store;
+    server.ctx.data_file = data_file;
+
+    server.listen_fd = open_socket(address, true);
+    if (server.listen_fd < 0) return false;
+
+    server.epoll_fd = epoll_create1(0);
+    struct epoll_event listen_event;
+    listen_event.events = EPOLLIN;
+    listen_event.data.ptr = NULL;
+
+    if (server.epoll_fd < 0 || !set_nonblocking(server.listen_fd) ||
+        epoll_ctl(server.epoll_fd, EPOLL_CTL_ADD, server.listen_fd, &listen_event) != 0) {
+        fprintf(stderr, "Error: Cannot start event loop: %s\n", strerror(errno));
+        if (server.epoll_fd >= 0) close(server.epoll_fd);
+        close(server.listen_fd);
+        return false;
+    }
+
+    // No SA_RESTART, so a signal interrupts epoll_wait
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = handle_stop_signal;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGINT, &action, NULL);
+    sigaction(SIGTERM, &action, NULL);
+    stop_requested = 0;
+
+    printf("Serving %d categories on %s\n", store->category_count, address);
+    fflush(stdout);
+
+    struct epoll_event events[SERVER_MAX_EVENTS];
+    bool ok = true;
+
+    while (!stop_requested) {
+        int count = epoll_wait(server.epoll_fd, events, SERVER_MAX_EVENTS, -1);
+        if (count < 0) {
+            if (errno == EINTR) continue;
+            fprintf(stderr, "Error: epoll_wait failed: %s\n", strerror(errno));
+            ok = false;
+            break;
+        }
+
+        for (int i = 0; i < count; i++) {
+            if (events[i].data.ptr == NULL) {
+                accept_connections(&server);
+            } else {
+                connection_event(&server, (Connection*)events[i].data.ptr, events[i].events);
+            }
+        }
+    }
+
+    while (server.connections) {
+        connection_close(&server, server.connections);
+    }
+    close(server.epoll_fd);
+    close(server.listen_fd);
+    if (strchr(address, '/')) {
+        remove_socket_file(address);
+    }
+
+    return ok;
+}
+
+// ============================================================================
+// Client
+// ============================================================================
+
+typedef struct {
+    int sent;                  // Requests written to the buffer
+    int answered;              // Responses fully read
+    int lines_left;            // Result lines still due for the current response
+    bool ok;
+} ClientState;
+
+/**
+ * @brief Print every complete response line received so far
+ * @return false on a malformed response
+ */
+static bool print_responses(ClientState* state, Buffer* in) {
+    size_t start = 0;
+
+    while (start < in->length) {
+        char* line = in->data + start;
+        char* newline = (char*)memchr(line, '\n', in->length - start);
+        if (!newline) break;
+
+        size_t length = (size_t)(newline - line) + 1;
+        start += length;
+
+        if (state->lines_left > 0) {
+            fwrite(line, 1, length, stdout);
+            if (--state->lines_left == 0) state->answered++;
+        } else if (strncmp(line, "OK ", 3) == 0) {
+            state->lines_left = atoi(line + 3);
+            if (state->lines_left == 0) state->answered++;
+        } else if (strncmp(line, "ERR\n", 4) == 0) {
+            state->answered++;
+            state->ok = false;
+            fprintf(stderr, "Error: request %d failed\n", state->answered);
+        } else {
+            fprintf(stderr, "Error: Malformed response from server\n");
+            return false;
+        }
+    }
+
+    buffer_consume(in, start);
+    return true;
+}
+
+bool client_run(const char* address, FILE* input) {
+    if (!address || !input) {
+        fprintf(stderr, "Error: Invalid parameters for client\n");
+        return false;
+    }
+
+    int fd = open_socket(address, false);
+    if (fd < 0) return false;
+    if (!set_nonblocking(fd)) {
+        close(fd);
+        return false;
+    }
+
+    Buffer out = {NULL, 0, 0};
+    Buffer in = {NULL, 0, 0};
+    ClientState state = {0, 0, 0, true};
+    bool input_done = false;
+    bool write_closed = false;
+    bool failed = false;
+    char line[COMMAND_LINE_SIZE];
+
+    while (!failed) {
+        // Keep a window of requests queued without reading the whole script
+        while (!input_done && out.length < SERVER_READ_CHUNK) {
+            if (!fgets(line, sizeof(line), input)) {
+                input_done = true;
+                break;
+            }
+
+            size_t length = strlen(line);
+            if (!buffer_append(&out, line, length) ||
+                (line[length - 1] != '\n' && !buffer_append(&out, "\n", 1))) {
+                failed = true;
+                break;
+            }
+            state.sent++;
+        }
+        if (failed) break;
+
+        if (input_done && out.length == 0 && !write_closed) {
+            shutdown(fd, SHUT_WR);
+            write_closed = true;
+        }
+
+        struct pollfd pfd;
+        pfd.fd = fd;
+        pfd.events = POLLIN | (out.length > 0 ? POLLOUT : 0);
+        if (poll(&pfd, 1, -1) < 0) {
+            if (errno == EINTR) continue;
+            failed = true;
+            break;
+        }
+
+        if (pfd.revents & POLLOUT) {
+            ssize_t n = send(fd, out.data, out.length, MSG_NOSIGNAL);
+            if (n > 0) {
+                buffer_consume(&out, (size_t)n);
+            } else if (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                failed = true;
+                break;
+            }
+        }
+
+        if (pfd.revents & (POLLIN | POLLHUP | POLLERR)) {
+            if (!buffer_reserve(&in, SERVER_READ_CHUNK)) {
+                failed = true;
+                break;
+            }
+
+            ssize_t n = recv(fd, in.data + in.length, SERVER_READ_CHUNK, 0);
+            if (n > 0) {
+                in.length += (size_t)n;
+                failed = !print_responses(&state, &in);
+            } else if (n == 0) {
+                break;
+            } else if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                failed = true;
+            }
+        }
+    }
+
+    if (!failed && state.answered != state.sent) {
+        fprintf(stderr, "Error: Connection closed with %d of %d requests unanswered\n",
+                state.sent - state.answered, state.sent);
+        failed = true;
+    } else if (failed) {
+        fprintf(stderr, "Error: Connection to %s failed\n", address);
+    }
+
+    fflush(stdout);
+    buffer_free(&out);
+    buffer_free(&in);
+    close(fd);
+    return state.ok && !failed;
+}
+
+#else
+
+bool server_run(DataStore* store, const char* address, const char* data_file) {
+    (void)store;
+    (void)address;
+    (void)data_file;
+    fprintf(stderr, "Error: Server mode requires Linux (epoll)\n");
+    return false;
+}
+
+bool client_run(const char* address, FILE* input) {
+    (void)address;
+    (void)input;
+    fprintf(stderr, "Error: Client mode requires Linux\n");
+    return false;
+}
+
+#endif
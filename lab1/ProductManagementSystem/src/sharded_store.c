@@ -0,0 +1,403 @@
+/**
+ * @file sharded_store.c
+ * @brief Category-partitioned store implementation
+ * @author PMS Team
+ * @date 2025
+ * @compatible Dev-C++ 6.3, TDM-GCC 9.2.0, C11
+ */
+
+#include "../include/sharded_store.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <limits.h>
+
+bool sharded_store_init(ShardedStore* store, int shard_count, int thread_count) {
+    if (!store || shard_count < 1 || shard_count > SHARDED_STORE_MAX_SHARDS) {
+        fprintf(stderr, "Error: Invalid shard count\n");
+        return false;
+    }
+
+    store->shards = (DataStore*)calloc(shard_count, sizeof(DataStore));
+    if (!store->shards) {
+        fprintf(stderr, "Error: Failed to allocate shards\n");
+        return false;
+    }
+
+    store->shard_count = 0;
+    store->pool = NULL;
+    atomic_init(&store->next_shard, 0);
+
+    for (int i = 0; i < shard_count; i++) {
+        DataStore* shard = &store->shards[i];
+        *shard = datastore_init();
+        store->shard_count++;
+
+        if (!datastore_enable_concurrency(shard)) {
+            sharded_store_free(store);
+            return false;
+        }
+
+        // Shard i owns every ID congruent to i + 1 modulo the shard count
+        atomic_store(&shard->next_category_id, i + 1);
+        atomic_store(&shard->next_subgroup_id, i + 1);
+        atomic_store(&shard->next_product_id, i + 1);
+        shard->ids_striped = true;
+    }
+
+    if (thread_count != 1) {
+        store->pool = thread_pool_create(thread_count);
+        if (!store->pool) {
+            sharded_store_free(store);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void sharded_store_free(ShardedStore* store) {
+    if (!store) return;
+
+    for (int i = 0; i < store->shard_count; i++) {
+        datastore_free(&store->shards[i]);
+    }
+    free(store->shards);
+    store->shards = NULL;
+    store->shard_count = 0;
+
+    thread_pool_destroy(store->pool);
+    store->pool = NULL;
+}
+
+int sharded_store_shard_of(const ShardedStore* store, int id) {
+    if (!store || store->shard_count == 0 || id <= 0) return -1;
+    return (id - 1) % store->shard_count;
+}
+
+DataStore* sharded_store_shard_for(ShardedStore* store, int id) {
+    int index = sharded_store_shard_of(store, id);
+    return index >= 0 ? &store->shards[index] : NULL;
+}
+
+/**
+ * @brief Next ID of a kind owned by the given shard
+ * @return New ID, 0 on failure
+ */
+static int allocate_shard_id(ShardedStore* store, DataStore* shard, IdKind kind) {
+    atomic_int* counter = kind == ID_CATEGORY ? &shard->next_category_id :
+                          kind == ID_SUBGROUP ? &shard->next_subgroup_id :
+                                                &shard->next_product_id;
+
+    int id = atomic_fetch_add(counter, store->shard_count);
+    if (id <= 0 || id > INT_MAX - store->shard_count) {
+        fprintf(stderr, "Error: ID space exhausted\n");
+        return 0;
+    }
+    return id;
+}
+
+// ============================================================================
+// Mutations
+// ============================================================================
+
+int sharded_store_add_category(ShardedStore* store, const char* name, const char* description) {
+    if (!store || store->shard_count == 0) {
+        fprintf(stderr, "Error: ShardedStore pointer is NULL\n");
+        return 0;
+    }
+
+    DataStore* shard = &store->shards[atomic_fetch_add(&store->next_shard, 1) % store->shard_count];
+    int id = allocate_shard_id(store, shard, ID_CATEGORY);
+    if (id == 0) return 0;
+
+    Category category = category_create(id, name, description);
+    if (!datastore_add_category(shard, category)) {
+        category_free(&category);
+        return 0;
+    }
+    return id;
+}
+
+int sharded_store_add_subgroup(ShardedStore* store, int category_id,
+                               const char* name, const char* description) {
+    DataStore* shard = sharded_store_shard_for(store, category_id);
+    if (!shard) {
+        fprintf(stderr, "Error: Category ID %d not found\n", category_id);
+        return 0;
+    }
+
+    int id = allocate_shard_id(store, shard, ID_SUBGROUP);
+    if (id == 0) return 0;
+
+    Subgroup subgroup = subgroup_create(id, category_id, name, description);
+    if (!datastore_add_subgroup(shard, category_id, subgroup)) {
+        subgroup_free(&subgroup);
+        return 0;
+    }
+    return id;
+}
+
+int sharded_store_add_product(ShardedStore* store, int subgroup_id, Product product) {
+    DataStore* shard = sharded_store_shard_for(store, subgroup_id);
+    if (!shard) {
+        fprintf(stderr, "Error: Subgroup ID %d not found\n", subgroup_id);
+        return 0;
+    }
+
+    product.id = allocate_shard_id(store, shard, ID_PRODUCT);
+    product.subgroup_id = subgroup_id;
+    if (product.id == 0 || !datastore_add_product(shard, subgroup_id, product)) {
+        return 0;
+    }
+    return product.id;
+}
+
+bool sharded_store_remove_category(ShardedStore* store, int category_id) {
+    DataStore* shard = sharded_store_shard_for(store, category_id);
+    return shard && datastore_remove_category(shard, category_id);
+}
+
+bool sharded_store_remove_subgroup(ShardedStore* store, int subgroup_id) {
+    DataStore* shard = sharded_store_shard_for(store, subgroup_id);
+    return shard && datastore_remove_subgroup(shard, subgroup_id);
+}
+
+bool sharded_store_remove_product(ShardedStore* store, int product_id) {
+    DataStore* shard = sharded_store_shard_for(store, product_id);
+    return shard && datastore_remove_product(shard, product_id);
+}
+
+// ============================================================================
+// Fan-out queries
+// ============================================================================
+
+typedef enum {
+    SHARD_QUERY_NAME,
+    SHARD_QUERY_PRICE,
+    SHARD_QUERY_QUANTITY,
+    SHARD_QUERY_STATISTICS
+} ShardQueryKind;
+
+typedef struct {
+    ShardedStore* store;
+    ShardQueryKind kind;
+    const char* name;
+    float min_price, max_price;
+    int min_qty, max_qty;
+    SearchResult* results;     // One per shard
+    Statistics* statistics;    // One per shard
+} ShardQuery;
+
+static void shard_query_task(void* context, int shard_index) {
+    ShardQuery* query = (ShardQuery*)context;
+    DataStore* shard = &query->store->shards[shard_index];
+
+    switch (query->kind) {
+        case SHARD_QUERY_NAME:
+            query->results[shard_index] = datastore_search_products_by_name(shard, query->name);
+            break;
+        case SHARD_QUERY_PRICE:
+            query->results[shard_index] = datastore_search_products_by_price(shard, query->min_price,
+                                                                            query->max_price);
+            break;
+        case SHARD_QUERY_QUANTITY:
+            query->results[shard_index] = datastore_search_products_by_quantity(shard, query->min_qty,
+                                                                               query->max_qty);
+            break;
+        case SHARD_QUERY_STATISTICS:
+            query->statistics[shard_index] = datastore_get_statistics(shard);
+            break;
+    }
+}
+
+/**
+ * @brief Run a search on every shard and concatenate the results in shard order
+ */
+static SearchResult sharded_search(ShardedStore* store, ShardQuery* query) {
+    SearchResult merged = {NULL, 0};
+
+    query->results = (SearchResult*)calloc(store->shard_count, sizeof(SearchResult));
+    if (!query->results) {
+        fprintf(stderr, "Error: Failed to allocate memory for search results\n");
+        return merged;
+    }
+
+    thread_pool_run(store->pool, shard_query_task, query, store->shard_count);
+
+    int total = 0;
+    for (int i = 0; i < store->shard_count; i++) {
+        total += query->results[i].count;
+    }
+
+    if (total > 0) {
+        merged.products = (Product*)malloc(total * sizeof(Product));
+        if (!merged.products) {
+            fprintf(stderr, "Error: Failed to allocate memory for search results\n");
+        } else {
+            for (int i = 0; i < store->shard_count; i++) {
+                if (query->results[i].count > 0) {
+                    memcpy(merged.products + merged.count, query->results[i].products,
+                           query->results[i].count * sizeof(Product));
+                    merged.count += query->results[i].count;
+                }
+            }
+        }
+    }
+
+    for (int i = 0; i < store->shard_count; i++) {
+        search_result_free(&query->results[i]);
+    }
+    free(query->results);
+    return merged;
+}
+
+SearchResult sharded_store_search_by_name(ShardedStore* store, const char* name) {
+    SearchResult empty = {NULL, 0};
+    if (!store || !name) return empty;
+
+    ShardQuery query = {0};
+    query.store = store;
+    query.kind = SHARD_QUERY_NAME;
+    query.name = name;
+    return sharded_search(store, &query);
+}
+
+SearchResult sharded_store_search_by_price(ShardedStore* store, float min_price, float max_price) {
+    SearchResult empty = {NULL, 0};
+    if (!store) return empty;
+
+    ShardQuery query = {0};
+    query.store = store;
+    query.kind = SHARD_QUERY_PRICE;
+    query.min_price = min_price;
+    query.max_price = max_price;
+    return sharded_search(store, &query);
+}
+
+SearchResult sharded_store_search_by_quantity(ShardedStore* store, int min_qty, int max_qty) {
+    SearchResult empty = {NULL, 0};
+    if (!store) return empty;
+
+    ShardQuery query = {0};
+    query.store = store;
+    query.kind = SHARD_QUERY_QUANTITY;
+    query.min_qty = min_qty;
+    query.max_qty = max_qty;
+    return sharded_search(store, &query);
+}
+
+Statistics sharded_store_get_statistics(ShardedStore* store) {
+    Statistics total = {0, 0, 0, 0.0f, 0.0f, 0};
+    if (!store || store->shard_count == 0) return total;
+
+    ShardQuery query = {0};
+    query.store = store;
+    query.kind = SHARD_QUERY_STATISTICS;
+    query.statistics = (Statistics*)calloc(store->shard_count, sizeof(Statistics));
+    if (!query.statistics) {
+        fprintf(stderr, "Error: Failed to allocate memory for statistics\n");
+        return total;
+    }
+
+    thread_pool_run(store->pool, shard_query_task, &query, store->shard_count);
+
+    // Combine in shard order so the float sums do not depend on scheduling
+    double value = 0.0;
+    double price_sum = 0.0;
+    for (int i = 0; i < store->shard_count; i++) {
+        const Statistics* part = &query.statistics[i];
+        total.total_categories += part->total_categories;
+        total.total_subgroups += part->total_subgroups;
+        total.total_products += part->total_products;
+        total.total_quantity += part->total_quantity;
+        value += part->total_value;
+        price_sum += (double)part->average_price * part->total_products;
+    }
+
+    total.total_value = (float)value;
+    if (total.total_products > 0) {
+        total.average_price = (float)(price_sum / total.total_products);
+    }
+
+    free(query.statistics);
+    return total;
+}
+
+// ============================================================================
+// Persistence
+// ============================================================================
+
+static void shard_file_path(const char* base_path, int shard_index, char* buffer, size_t size) {
+    snprintf(buffer, size, "%s.shard%d.dat", base_path, shard_index);
+}
+
+/**
+ * @brief Check that every ID in a loaded shard routes back to it
+ */
+static bool shard_is_consistent(const ShardedStore* store, DataStore* shard, int shard_index) {
+    bool ok = (atomic_load(&shard->next_category_id) - 1) % store->shard_count == shard_index &&
+              (atomic_load(&shard->next_subgroup_id) - 1) % store->shard_count == shard_index &&
+              (atomic_load(&shard->next_product_id) - 1) % store->shard_count == shard_index;
+
+    for (int i = 0; ok && i < shard->category_count; i++) {
+        const Category* cat = &shard->categories[i];
+        ok = sharded_store_shard_of(store, cat->id) == shard_index;
+
+        for (int j = 0; ok && j < cat->subgroup_count; j++) {
+            const Subgroup* sub = &cat->subgroups[j];
+            ok = sharded_store_shard_of(store, sub->id) == shard_index;
+
+            for (int k = 0; ok && k < sub->product_count; k++) {
+                ok = sharded_store_shard_of(store, sub->products[k].id) == shard_index;
+            }
+        }
+    }
+
+    return ok;
+}
+
+bool sharded_store_save(ShardedStore* store, const char* base_path) {
+    if (!store || !base_path) {
+        fprintf(stderr, "Error: Invalid parameters for save\n");
+        return false;
+    }
+
+    bool ok = true;
+    for (int i = 0; i < store->shard_count; i++) {
+        char path[512];
+        shard_file_path(base_path, i, path, sizeof(path));
+        ok = datastore_save(&store->shards[i], path) && ok;
+    }
+    return ok;
+}
+
+bool sharded_store_load(ShardedStore* store, const char* base_path) {
+    if (!store || !base_path) {
+        fprintf(stderr, "Error: Invalid parameters for load\n");
+        return false;
+    }
+
+    bool ok = true;
+    for (int i = 0; i < store->shard_count; i++) {
+        DataStore* shard = &store->shards[i];
+        char path[512];
+        shard_file_path(base_path, i, path, sizeof(path));
+
+        if (!datastore_load(shard, path)) {
+            ok = false;
+            continue;
+        }
+
+        datastore_read_lock(shard);
+        bool consistent = shard_is_consistent(store, shard, i);
+        datastore_read_unlock(shard);
+
+        if (!consistent) {
+            fprintf(stderr, "Error: %s was not written by shard %d of %d\n",
+                    path, i, store->shard_count);
+            ok = false;
+        }
+    }
+    return ok;
+}
@@ -0,0 +1,430 @@
+/**
+ * @file simd_filter.c
+ * @brief Range filter kernels (AVX2 / SSE2 / scalar, chosen at runtime)
+ * @author PMS Team
+ * @date 2025
+ * @compatible Dev-C++ 6.3, TDM-GCC 9.2.0, C11
+ */
+
+#include "../include/simd_filter.h"
+#include <stddef.h>
+#include <string.h>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define PMS_FILTER_X86 1
+#include <immintrin.h>
+#endif
+
+typedef enum {
+    KERNEL_SCALAR,
+    KERNEL_SSE2,
+    KERNEL_AVX2
+} FilterKernel;
+
+static int forced_kernel = -1;     // FilterKernel set by filter_force_kernel, -1 for none
+
+static bool kernel_supported(FilterKernel kernel) {
+    switch (kernel) {
+        #ifdef PMS_FILTER_X86
+        case KERNEL_AVX2: return __builtin_cpu_supports("avx2");
+        case KERNEL_SSE2: return __builtin_cpu_supports("sse2");
+        #endif
+        case KERNEL_SCALAR: return true;
+        default: return false;
+    }
+}
+
+static FilterKernel select_kernel(void) {
+    if (forced_kernel >= 0) return (FilterKernel)forced_kernel;
+
+    #ifdef PMS_FILTER_X86
+    // Reads CPUID results cached by libgcc at startup, cheap enough per call
+    if (__builtin_cpu_supports("avx2")) return KERNEL_AVX2;
+    if (__builtin_cpu_supports("sse2")) return KERNEL_SSE2;
+    #endif
+    return KERNEL_SCALAR;
+}
+
+static int popcount64(uint64_t word) {
+    #if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(word);
+    #else
+    int count = 0;
+    while (word) {
+        word &= word - 1;
+        count++;
+    }
+    return count;
+    #endif
+}
+
+const char* filter_kernel_name(void) {
+    switch (select_kernel()) {
+        case KERNEL_AVX2: return "avx2";
+        case KERNEL_SSE2: return "sse2";
+        default:          return "scalar";
+    }
+}
+
+bool filter_force_kernel(const char* name) {
+    if (!name) {
+        forced_kernel = -1;
+        return true;
+    }
+
+    FilterKernel kernel;
+    if (strcmp(name, "avx2") == 0) {
+        kernel = KERNEL_AVX2;
+    } else if (strcmp(name, "sse2") == 0) {
+        kernel = KERNEL_SSE2;
+    } else if (strcmp(name, "scalar") == 0) {
+        kernel = KERNEL_SCALAR;
+    } else {
+        return false;
+    }
+
+    if (!kernel_supported(kernel)) return false;
+    forced_kernel = (int)kernel;
+    return true;
+}
+
+// ============================================================================
+// Scalar kernels (also used for the tail that does not fill a 64-row word)
+// ============================================================================
+
+static int price_range_scalar(const float* prices, int begin, int end,
+                              float min_price, float max_price, uint64_t* bitmap) {
+    int matches = 0;
+    for (int i = begin; i < end; i++) {
+        if (prices[i] >= min_price && prices[i] <= max_price) {
+            bitmap[i / 64] |= (uint64_t)1 << (i % 64);
+            matches++;
+        }
+    }
+    return matches;
+}
+
+static int quantity_range_scalar(const int* quantities, int begin, int end,
+                                 int min_qty, int max_qty, uint64_t* bitmap) {
+    int matches = 0;
+    for (int i = begin; i < end; i++) {
+        if (quantities[i] >= min_qty && quantities[i] <= max_qty) {
+            bitmap[i / 64] |= (uint64_t)1 << (i % 64);
+            matches++;
+        }
+    }
+    return matches;
+}
+
+static char fold_char(char c) {
+    return (c >= 'A' && c <= 'Z') ? (char)(c + ('a' - 'A')) : c;
+}
+
+/**
+ * @brief Compare needle[from..needle_len) with text at position, folding case
+ */
+static int matches_at(const char* text, const char* needle, size_t from, size_t needle_len) {
+    for (size_t k = from; k < needle_len; k++) {
+        if (fold_char(text[k]) != needle[k]) return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief Check candidate start positions [begin, last] one by one
+ */
+static int contains_scalar(const char* text, size_t begin, size_t last,
+                           const char* needle, size_t needle_len) {
+    for (size_t i = begin; i <= last; i++) {
+        if (fold_char(text[i]) == needle[0] && matches_at(text + i, needle, 1, needle_len)) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// ============================================================================
+// x86 kernels, one bitmap word (64 rows) per outer iteration
+// ============================================================================
+
+#ifdef PMS_FILTER_X86
+
+__attribute__((target("avx2")))
+static int price_range_avx2(const float* prices, int words,
+                            float min_price, float max_price, uint64_t* bitmap) {
+    const __m256 lo = _mm256_set1_ps(min_price);
+    const __m256 hi = _mm256_set1_ps(max_price);
+    int matches = 0;
+
+    for (int w = 0; w < words; w++) {
+        const float* block = prices + (size_t)w * 64;
+        uint64_t word = 0;
+
+        for (int i = 0; i < 64; i += 8) {
+            __m256 v = _mm256_loadu_ps(block + i);
+            __m256 in_range = _mm256_and_ps(_mm256_cmp_ps(v, lo, _CMP_GE_OQ),
+                                            _mm256_cmp_ps(v, hi, _CMP_LE_OQ));
+            word |= (uint64_t)(unsigned)_mm256_movemask_ps(in_range) << i;
+        }
+
+        bitmap[w] = word;
+        matches += popcount64(word);
+    }
+    return matches;
+}
+
+__attribute__((target("avx2")))
+static int quantity_range_avx2(const int* quantities, int words,
+                               int min_qty, int max_qty, uint64_t* bitmap) {
+    const __m256i lo = _mm256_set1_epi32(min_qty);
+    const __m256i hi = _mm256_set1_epi32(max_qty);
+    int matches = 0;
+
+    for (int w = 0; w < words; w++) {
+        const int* block = quantities + (size_t)w * 64;
+        uint64_t word = 0;
+
+        for (int i = 0; i < 64; i += 8) {
+            __m256i v = _mm256_loadu_si256((const __m256i*)(block + i));
+            // Outside the range when lo > v or v > hi
+            __m256i outside = _mm256_or_si256(_mm256_cmpgt_epi32(lo, v),
+                                              _mm256_cmpgt_epi32(v, hi));
+            unsigned mask = (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(outside));
+            word |= (uint64_t)(~mask & 0xFFu) << i;
+        }
+
+        bitmap[w] = word;
+        matches += popcount64(word);
+    }
+    return matches;
+}
+
+__attribute__((target("sse2")))
+static int price_range_sse2(const float* prices, int words,
+                            float min_price, float max_price, uint64_t* bitmap) {
+    const __m128 lo = _mm_set1_ps(min_price);
+    const __m128 hi = _mm_set1_ps(max_price);
+    int matches = 0;
+
+    for (int w = 0; w < words; w++) {
+        const float* block = prices + (size_t)w * 64;
+        uint64_t word = 0;
+
+        for (int i = 0; i < 64; i += 4) {
+            __m128 v = _mm_loadu_ps(block + i);
+            __m128 in_range = _mm_and_ps(_mm_cmpge_ps(v, lo), _mm_cmple_ps(v, hi));
+            word |= (uint64_t)(unsigned)_mm_movemask_ps(in_range) << i;
+        }
+
+        bitmap[w] = word;
+        matches += popcount64(word);
+    }
+    return matches;
+}
+
+__attribute__((target("sse2")))
+static int quantity_range_sse2(const int* quantities, int words,
+                               int min_qty, int max_qty, uint64_t* bitmap) {
+    const __m128i lo = _mm_set1_epi32(min_qty);
+    const __m128i hi = _mm_set1_epi32(max_qty);
+    int matches = 0;
+
+    for (int w = 0; w < words; w++) {
+        const int* block = quantities + (size_t)w * 64;
+        uint64_t word = 0;
+
+        for (int i = 0; i < 64; i += 4) {
+            __m128i v = _mm_loadu_si128((const __m128i*)(block + i));
+            __m128i outside = _mm_or_si128(_mm_cmpgt_epi32(lo, v), _mm_cmpgt_epi32(v, hi));
+            unsigned mask = (unsigned)_mm_movemask_ps(_mm_castsi128_ps(outside));
+            word |= (uint64_t)(~mask & 0xFu) << i;
+        }
+
+        bitmap[w] = word;
+        matches += popcount64(word);
+    }
+    return matches;
+}
+
+/*
+ * Case-insensitive substring test for one field: for each block of W start
+ * positions, fold the bytes at i and at i + needle_len - 1, compare them with
+ * the first and last needle characters, and verify the middle only where
+ * both match. Blocks that would read past field_size go to contains_scalar.
+ */
+
+__attribute__((target("avx2")))
+static __m256i fold_case_avx2(__m256i v) {
+    __m256i upper = _mm256_and_si256(_mm256_cmpgt_epi8(v, _mm256_set1_epi8('A' - 1)),
+                                     _mm256_cmpgt_epi8(_mm256_set1_epi8('Z' + 1), v));
+    return _mm256_or_si256(v, _mm256_and_si256(upper, _mm256_set1_epi8(0x20)));
+}
+
+__attribute__((target("avx2")))
+static int contains_avx2(const char* text, size_t text_len, size_t field_size,
+                         const char* needle, size_t needle_len) {
+    const __m256i first = _mm256_set1_epi8(needle[0]);
+    const __m256i last = _mm256_set1_epi8(needle[needle_len - 1]);
+    size_t last_start = text_len - needle_len;
+    size_t i = 0;
+
+    for (; i <= last_start && i + needle_len - 1 + 32 <= field_size; i += 32) {
+        __m256i block_first = fold_case_avx2(_mm256_loadu_si256((const __m256i*)(text + i)));
+        __m256i block_last = fold_case_avx2(_mm256_loadu_si256((const __m256i*)(text + i + needle_len - 1)));
+        unsigned mask = (unsigned)_mm256_movemask_epi8(
+            _mm256_and_si256(_mm256_cmpeq_epi8(block_first, first), _mm256_cmpeq_epi8(block_last, last)));
+
+        // Drop start positions past the end of the string
+        if (last_start - i < 31) {
+            mask &= (2u << (last_start - i)) - 1;
+        }
+
+        while (mask) {
+            int bit = __builtin_ctz(mask);
+            if (matches_at(text + i + bit, needle, 1, needle_len - 1)) return 1;
+            mask &= mask - 1;
+        }
+    }
+
+    return i <= last_start ? contains_scalar(text, i, last_start, needle, needle_len) : 0;
+}
+
+__attribute__((target("sse2")))
+static __m128i fold_case_sse2(__m128i v) {
+    __m128i upper = _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8('A' - 1)),
+                                  _mm_cmplt_epi8(v, _mm_set1_epi8('Z' + 1)));
+    return _mm_or_si128(v, _mm_and_si128(upper, _mm_set1_epi8(0x20)));
+}
+
+__attribute__((target("sse2")))
+static int contains_sse2(const char* text, size_t text_len, size_t field_size,
+                         const char* needle, size_t needle_len) {
+    const __m128i first = _mm_set1_epi8(needle[0]);
+    const __m128i last = _mm_set1_epi8(needle[needle_len - 1]);
+    size_t last_start = text_len - needle_len;
+    size_t i = 0;
+
+    for (; i <= last_start && i + needle_len - 1 + 16 <= field_size; i += 16) {
+        __m128i block_first = fold_case_sse2(_mm_loadu_si128((const __m128i*)(text + i)));
+        __m128i block_last = fold_case_sse2(_mm_loadu_si128((const __m128i*)(text + i + needle_len - 1)));
+        unsigned mask = (unsigned)_mm_movemask_epi8(
+            _mm_and_si128(_mm_cmpeq_epi8(block_first, first), _mm_cmpeq_epi8(block_last, last)));
+
+        if (last_start - i < 15) {
+            mask &= (2u << (last_start - i)) - 1;
+        }
+
+        while (mask) {
+            int bit = __builtin_ctz(mask);
+            if (matches_at(text + i + bit, needle, 1, needle_len - 1)) return 1;
+            mask &= mask - 1;
+        }
+    }
+
+    return i <= last_start ? contains_scalar(text, i, last_start, needle, needle_len) : 0;
+}
+
+#endif // PMS_FILTER_X86
+
+// ============================================================================
+// Public entry points
+// ============================================================================
+
+int filter_price_range(const float* prices, int count, float min_price, float max_price, uint64_t* bitmap) {
+    if (!prices || !bitmap || count <= 0) return 0;
+
+    int words = count / 64;
+    int matches = 0;
+
+    // Tail word is OR-ed into by the scalar kernel
+    bitmap[FILTER_BITMAP_WORDS(count) - 1] = 0;
+
+    switch (select_kernel()) {
+        #ifdef PMS_FILTER_X86
+        case KERNEL_AVX2:
+            matches = price_range_avx2(prices, words, min_price, max_price, bitmap);
+            break;
+        case KERNEL_SSE2:
+            matches = price_range_sse2(prices, words, min_price, max_price, bitmap);
+            break;
+        #endif
+        default:
+            for (int w = 0; w < words; w++) bitmap[w] = 0;
+            matches = price_range_scalar(prices, 0, words * 64, min_price, max_price, bitmap);
+            break;
+    }
+
+    return matches + price_range_scalar(prices, words * 64, count, min_price, max_price, bitmap);
+}
+
+int filter_quantity_range(const int* quantities, int count, int min_qty, int max_qty, uint64_t* bitmap) {
+    if (!quantities || !bitmap || count <= 0) return 0;
+
+    int words = count / 64;
+    int matches = 0;
+
+    bitmap[FILTER_BITMAP_WORDS(count) - 1] = 0;
+
+    switch (select_kernel()) {
+        #ifdef PMS_FILTER_X86
+        case KERNEL_AVX2:
+            matches = quantity_range_avx2(quantities, words, min_qty, max_qty, bitmap);
+            break;
+        case KERNEL_SSE2:
+            matches = quantity_range_sse2(quantities, words, min_qty, max_qty, bitmap);
+            break;
+        #endif
+        default:
+            for (int w = 0; w < words; w++) bitmap[w] = 0;
+            matches = quantity_range_scalar(quantities, 0, words * 64, min_qty, max_qty, bitmap);
+            break;
+    }
+
+    return matches + quantity_range_scalar(quantities, words * 64, count, min_qty, max_qty, bitmap);
+}
+
+int filter_text_contains(const char* first_field, size_t stride, size_t field_size, int count,
+                         const char* needle, size_t needle_len, uint64_t* bitmap) {
+    if (!first_field || !needle || !bitmap || count <= 0) return 0;
+
+    FilterKernel kernel = select_kernel();
+    int matches = 0;
+
+    for (int w = 0; w < FILTER_BITMAP_WORDS(count); w++) {
+        bitmap[w] = 0;
+    }
+
+    for (int row = 0; row < count; row++) {
+        const char* text = first_field + (size_t)row * stride;
+        const char* nul = (const char*)memchr(text, '\0', field_size);
+        size_t text_len = nul ? (size_t)(nul - text) : field_size;
+        int found;
+
+        if (needle_len == 0) {
+            found = 1;
+        } else if (needle_len > text_len) {
+            found = 0;
+        } else {
+            switch (kernel) {
+                #ifdef PMS_FILTER_X86
+                case KERNEL_AVX2:
+                    found = contains_avx2(text, text_len, field_size, needle, needle_len);
+                    break;
+                case KERNEL_SSE2:
+                    found = contains_sse2(text, text_len, field_size, needle, needle_len);
+                    break;
+                #endif
+                default:
+                    found = contains_scalar(text, 0, text_len - needle_len, needle, needle_len);
+                    break;
+            }
+        }
+
+        if (found) {
+            bitmap[row / 64] |= (uint64_t)1 << (row % 64);
+            matches++;
+        }
+    }
+
+    return matches;
+}
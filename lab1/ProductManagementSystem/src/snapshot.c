@@ -0,0 +1,532 @@
+/**
+ * @file snapshot.c
+ * @brief Multi-version snapshot publishing and epoch-based reclamation
+ * @author PMS Team
+ * @date 2025
+ * @compatible Dev-C++ 6.3, TDM-GCC 9.2.0, C11
+ */
+
+#include "../include/snapshot.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <limits.h>
+
+#define INITIAL_BLOCK_MAP_CAPACITY 64
+#define MAX_BLOCK_MAP_CAPACITY (1 << 30)
+#define INITIAL_LIST_CAPACITY 16
+
+void snapshot_domain_init(SnapshotDomain* domain) {
+    if (!domain) return;
+
+    atomic_init(&domain->current, NULL);
+    atomic_init(&domain->epoch, 1);
+    for (int i = 0; i < SNAPSHOT_MAX_READERS; i++) {
+        atomic_init(&domain->reader_epochs[i], 0);
+    }
+
+    domain->stamp = 0;
+    domain->verify = false;
+    domain->category_blocks.entries = NULL;
+    domain->category_blocks.capacity = 0;
+    domain->category_blocks.count = 0;
+    domain->subgroup_blocks.entries = NULL;
+    domain->subgroup_blocks.capacity = 0;
+    domain->subgroup_blocks.count = 0;
+    domain->retired = NULL;
+    domain->retired_count = 0;
+    domain->retired_capacity = 0;
+    domain->fresh = NULL;
+    domain->fresh_count = 0;
+    domain->fresh_capacity = 0;
+}
+
+// ============================================================================
+// Block helpers
+// ============================================================================
+
+static SubgroupBlock* subgroup_block_of(const Category* category) {
+    if (category->subgroup_count == 0) return NULL;
+    return (SubgroupBlock*)((char*)category->subgroups - offsetof(SubgroupBlock, items));
+}
+
+static ProductBlock* product_block_of(const Subgroup* subgroup) {
+    if (subgroup->product_count == 0) return NULL;
+    return (ProductBlock*)((char*)subgroup->products - offsetof(ProductBlock, items));
+}
+
+static bool remember_fresh(SnapshotDomain* domain, void* block) {
+    if (domain->fresh_count >= domain->fresh_capacity) {
+        int new_capacity = domain->fresh_capacity > 0 ? domain->fresh_capacity * 2 : INITIAL_LIST_CAPACITY;
+        void** new_list = (void**)realloc(domain->fresh, new_capacity * sizeof(void*));
+        if (!new_list) {
+            fprintf(stderr, "Error: Failed to expand snapshot allocation list\n");
+            return false;
+        }
+        domain->fresh = new_list;
+        domain->fresh_capacity = new_capacity;
+    }
+
+    domain->fresh[domain->fresh_count++] = block;
+    return true;
+}
+
+// ============================================================================
+// Block maps
+// ============================================================================
+
+/**
+ * @brief Home bucket of an ID (Fibonacci hashing, as in handle.c)
+ */
+static size_t block_map_bucket(int id, int capacity) {
+    return (size_t)(((uint32_t)id * 2654435769u) & (uint32_t)(capacity - 1));
+}
+
+/**
+ * @brief Bucket holding id, or the empty bucket where it would go
+ */
+static size_t block_map_find(const BlockMapEntry* entries, int capacity, int id) {
+    size_t mask = (size_t)capacity - 1;
+    size_t i = block_map_bucket(id, capacity);
+    while (entries[i].id != 0 && entries[i].id != id) {
+        i = (i + 1) & mask;
+    }
+    return i;
+}
+
+static void* block_map_get(const BlockMap* map, int id) {
+    if (id <= 0 || map->count == 0) return NULL;
+
+    const BlockMapEntry* entry = &map->entries[block_map_find(map->entries, map->capacity, id)];
+    return entry->id == id ? entry->block : NULL;
+}
+
+/**
+ * @brief Make room for one more ID, keeping the map at most half full
+ */
+static bool block_map_reserve(BlockMap* map) {
+    size_t needed = ((size_t)map->count + 1) * 2;
+    if (needed <= (size_t)map->capacity) return true;
+
+    size_t new_capacity = map->capacity > 0 ? (size_t)map->capacity * 2 : INITIAL_BLOCK_MAP_CAPACITY;
+    if (new_capacity > MAX_BLOCK_MAP_CAPACITY) {
+        fprintf(stderr, "Error: Snapshot block map is full\n");
+        return false;
+    }
+
+    BlockMapEntry* new_entries = (BlockMapEntry*)calloc(new_capacity, sizeof(BlockMapEntry));
+    if (!new_entries) {
+        fprintf(stderr, "Error: Failed to expand snapshot block map\n");
+        return false;
+    }
+
+    for (int i = 0; i < map->capacity; i++) {
+        if (map->entries[i].id != 0) {
+            new_entries[block_map_find(new_entries, (int)new_capacity, map->entries[i].id)] = map->entries[i];
+        }
+    }
+
+    free(map->entries);
+    map->entries = new_entries;
+    map->capacity = (int)new_capacity;
+    return true;
+}
+
+static bool block_map_set(BlockMap* map, int id, void* block) {
+    if (id <= 0) return true;
+    if (!block_map_reserve(map)) return false;
+
+    BlockMapEntry* entry = &map->entries[block_map_find(map->entries, map->capacity, id)];
+    if (entry->id == 0) {
+        entry->id = id;
+        map->count++;
+    }
+    entry->block = block;
+    return true;
+}
+
+/**
+ * @brief Remove the entry for id, shifting later entries of its run back
+ */
+static void block_map_remove(BlockMap* map, int id) {
+    if (id <= 0 || map->count == 0) return;
+
+    BlockMapEntry* entries = map->entries;
+    size_t mask = (size_t)map->capacity - 1;
+    size_t hole = block_map_find(entries, map->capacity, id);
+    if (entries[hole].id != id) return;
+
+    for (size_t j = (hole + 1) & mask; entries[j].id != 0; j = (j + 1) & mask) {
+        size_t home = block_map_bucket(entries[j].id, map->capacity);
+        bool stays = hole <= j ? (home > hole && home <= j) : (home > hole || home <= j);
+        if (!stays) {
+            entries[hole] = entries[j];
+            hole = j;
+        }
+    }
+
+    entries[hole].id = 0;
+    entries[hole].block = NULL;
+    map->count--;
+}
+
+/**
+ * @brief Remove a map entry if it still points at block
+ */
+static void block_map_forget(BlockMap* map, int id, const void* block) {
+    if (block_map_get(map, id) == block) {
+        block_map_remove(map, id);
+    }
+}
+
+static void block_map_clear(BlockMap* map) {
+    if (map->entries) {
+        memset(map->entries, 0, (size_t)map->capacity * sizeof(BlockMapEntry));
+    }
+    map->count = 0;
+}
+
+// ============================================================================
+// Invalidation
+// ============================================================================
+
+void snapshot_invalidate(SnapshotDomain* domain, int category_id, int subgroup_id) {
+    if (!domain) return;
+
+    block_map_remove(&domain->category_blocks, category_id);
+    block_map_remove(&domain->subgroup_blocks, subgroup_id);
+}
+
+void snapshot_invalidate_all(SnapshotDomain* domain) {
+    if (domain) domain->verify = true;
+}
+
+// ============================================================================
+// Publishing
+// ============================================================================
+
+/**
+ * @brief Find or build the immutable product array for a subgroup
+ * @return true if successful, *out is NULL for an empty subgroup
+ */
+static bool product_block_for(SnapshotDomain* domain, const Subgroup* subgroup,
+                              unsigned long stamp, ProductBlock** out) {
+    *out = NULL;
+    if (subgroup->product_count == 0) return true;
+
+    size_t bytes = subgroup->product_count * sizeof(Product);
+    ProductBlock* block = (ProductBlock*)block_map_get(&domain->subgroup_blocks, subgroup->id);
+    if (block && block->count == subgroup->product_count &&
+        (!domain->verify || memcmp(block->items, subgroup->products, bytes) == 0)) {
+        block->stamp = stamp;
+        *out = block;
+        return true;
+    }
+
+    block = (ProductBlock*)malloc(sizeof(ProductBlock) + bytes);
+    if (!block || !remember_fresh(domain, block)) {
+        fprintf(stderr, "Error: Failed to allocate snapshot products\n");
+        free(block);
+        return false;
+    }
+
+    block->stamp = stamp;
+    block->owner_id = subgroup->id;
+    block->count = subgroup->product_count;
+    memcpy(block->items, subgroup->products, bytes);
+
+    if (!block_map_set(&domain->subgroup_blocks, subgroup->id, block)) {
+        return false;
+    }
+
+    *out = block;
+    return true;
+}
+
+/**
+ * @brief Find or build the immutable subgroup array for a category
+ * @return true if successful, *out is NULL for a category without subgroups
+ */
+static bool subgroup_block_for(SnapshotDomain* domain, const Category* category,
+                               unsigned long stamp, SubgroupBlock** out) {
+    *out = NULL;
+    if (category->subgroup_count == 0) return true;
+
+    SubgroupBlock* block = (SubgroupBlock*)block_map_get(&domain->category_blocks, category->id);
+    if (block && !domain->verify && block->count == category->subgroup_count) {
+        block->stamp = stamp;
+        *out = block;
+        return true;
+    }
+
+    block = (SubgroupBlock*)malloc(sizeof(SubgroupBlock) + category->subgroup_count * sizeof(Subgroup));
+    if (!block || !remember_fresh(domain, block)) {
+        fprintf(stderr, "Error: Failed to allocate snapshot subgroups\n");
+        free(block);
+        return false;
+    }
+
+    block->stamp = stamp;
+    block->owner_id = category->id;
+    block->count = category->subgroup_count;
+    block->product_total = 0;
+
+    for (int i = 0; i < category->subgroup_count; i++) {
+        Subgroup* item = &block->items[i];
+        ProductBlock* products;
+
+        *item = category->subgroups[i];
+        if (!product_block_for(domain, &category->subgroups[i], stamp, &products)) {
+            return false;
+        }
+        item->products = products ? products->items : NULL;
+        item->product_capacity = item->product_count;
+        block->product_total += item->product_count;
+    }
+
+    if (!block_map_set(&domain->category_blocks, category->id, block)) {
+        return false;
+    }
+
+    *out = block;
+    return true;
+}
+
+static void retire_block(SnapshotDomain* domain, void* block, unsigned long epoch) {
+    if (domain->retired_count >= domain->retired_capacity) {
+        int new_capacity = domain->retired_capacity > 0 ? domain->retired_capacity * 2 : INITIAL_LIST_CAPACITY;
+        RetiredBlock* new_list = (RetiredBlock*)realloc(domain->retired, new_capacity * sizeof(RetiredBlock));
+        if (!new_list) {
+            // Freeing now could pull memory from under a reader, so leak instead
+            fprintf(stderr, "Error: Failed to expand snapshot retire list\n");
+            return;
+        }
+        domain->retired = new_list;
+        domain->retired_capacity = new_capacity;
+    }
+
+    domain->retired[domain->retired_count].block = block;
+    domain->retired[domain->retired_count].epoch = epoch;
+    domain->retired_count++;
+}
+
+/**
+ * @brief Retire the parts of an unlinked snapshot that the new one does not share
+ */
+static void retire_snapshot(SnapshotDomain* domain, Snapshot* old, unsigned long stamp, unsigned long epoch) {
+    for (int i = 0; i < old->category_count; i++) {
+        SubgroupBlock* subgroups = subgroup_block_of(&old->categories[i]);
+        if (!subgroups || subgroups->stamp == stamp) continue;
+
+        // A shared subgroup block implies all its product blocks are shared too
+        for (int j = 0; j < subgroups->count; j++) {
+            ProductBlock* products = product_block_of(&subgroups->items[j]);
+            if (!products || products->stamp == stamp) continue;
+
+            block_map_forget(&domain->subgroup_blocks, products->owner_id, products);
+            retire_block(domain, products, epoch);
+        }
+
+        block_map_forget(&domain->category_blocks, subgroups->owner_id, subgroups);
+        retire_block(domain, subgroups, epoch);
+    }
+
+    retire_block(domain, old, epoch);
+}
+
+/**
+ * @brief Free retired blocks that no pinned reader can still reach
+ */
+static void reclaim(SnapshotDomain* domain) {
+    unsigned long oldest = ULONG_MAX;
+    for (int i = 0; i < SNAPSHOT_MAX_READERS; i++) {
+        unsigned long pinned = atomic_load(&domain->reader_epochs[i]);
+        if (pinned != 0 && pinned < oldest) {
+            oldest = pinned;
+        }
+    }
+
+    int kept = 0;
+    for (int i = 0; i < domain->retired_count; i++) {
+        if (domain->retired[i].epoch < oldest) {
+            free(domain->retired[i].block);
+        } else {
+            domain->retired[kept++] = domain->retired[i];
+        }
+    }
+    domain->retired_count = kept;
+}
+
+/**
+ * @brief Undo a failed publish; the maps are dropped so nothing points at freed blocks
+ */
+static void abandon_publish(SnapshotDomain* domain, Snapshot* snapshot) {
+    for (int i = 0; i < domain->fresh_count; i++) {
+        free(domain->fresh[i]);
+    }
+    domain->fresh_count = 0;
+
+    block_map_clear(&domain->category_blocks);
+    block_map_clear(&domain->subgroup_blocks);
+    free(snapshot);
+}
+
+bool snapshot_publish(SnapshotDomain* domain, const SnapshotInfo* info,
+                      const Category* categories, int category_count) {
+    if (!domain || !info || (category_count > 0 && !categories)) {
+        fprintf(stderr, "Error: Invalid parameters for snapshot publish\n");
+        return false;
+    }
+
+    unsigned long stamp = ++domain->stamp;
+    domain->fresh_count = 0;
+
+    Snapshot* snapshot = (Snapshot*)malloc(sizeof(Snapshot) + category_count * sizeof(Category));
+    if (!snapshot) {
+        fprintf(stderr, "Error: Failed to allocate snapshot\n");
+        return false;
+    }
+
+    snapshot->info = *info;
+    snapshot->product_count = 0;
+    snapshot->category_count = category_count;
+
+    for (int i = 0; i < category_count; i++) {
+        Category* item = &snapshot->categories[i];
+        SubgroupBlock* subgroups;
+
+        *item = categories[i];
+        if (!subgroup_block_for(domain, &categories[i], stamp, &subgroups)) {
+            abandon_publish(domain, snapshot);
+            return false;
+        }
+        item->subgroups = subgroups ? subgroups->items : NULL;
+        item->subgroup_capacity = item->subgroup_count;
+        snapshot->product_count += subgroups ? subgroups->product_total : 0;
+    }
+
+    domain->fresh_count = 0;
+    domain->verify = false;
+
+    // Readers that pin after the epoch bump can only see the new snapshot
+    Snapshot* old = atomic_exchange(&domain->current, snapshot);
+    unsigned long epoch = atomic_fetch_add(&domain->epoch, 1);
+    if (old) {
+        retire_snapshot(domain, old, stamp, epoch);
+    }
+
+    reclaim(domain);
+    return true;
+}
+
+// ============================================================================
+// Readers
+// ============================================================================
+
+bool snapshot_pin(SnapshotDomain* domain, SnapshotPin* pin) {
+    if (!domain || !pin) return false;
+
+    pin->snapshot = NULL;
+    pin->slot = -1;
+
+    for (int i = 0; i < SNAPSHOT_MAX_READERS; i++) {
+        unsigned long expected = 0;
+        unsigned long epoch = atomic_load(&domain->epoch);
+        if (!atomic_compare_exchange_strong(&domain->reader_epochs[i], &expected, epoch)) {
+            continue;
+        }
+
+        // A writer may have bumped the epoch and scanned before our slot was set
+        unsigned long now;
+        while ((now = atomic_load(&domain->epoch)) != epoch) {
+            atomic_store(&domain->reader_epochs[i], now);
+            epoch = now;
+        }
+
+        pin->slot = i;
+        pin->snapshot = atomic_load(&domain->current);
+        return true;
+    }
+
+    fprintf(stderr, "Error: Too many concurrent snapshot readers\n");
+    return false;
+}
+
+void snapshot_unpin(SnapshotDomain* domain, SnapshotPin* pin) {
+    if (!domain || !pin || pin->slot < 0) return;
+
+    atomic_store(&domain->reader_epochs[pin->slot], 0);
+    pin->snapshot = NULL;
+    pin->slot = -1;
+}
+
+void snapshot_domain_free(SnapshotDomain* domain) {
+    if (!domain) return;
+
+    Snapshot* current = atomic_load(&domain->current);
+    if (current) {
+        for (int i = 0; i < current->category_count; i++) {
+            SubgroupBlock* subgroups = subgroup_block_of(&current->categories[i]);
+            if (!subgroups) continue;
+
+            for (int j = 0; j < subgroups->count; j++) {
+                free(product_block_of(&subgroups->items[j]));
+            }
+            free(subgroups);
+        }
+        free(current);
+    }
+
+    for (int i = 0; i < domain->retired_count; i++) {
+        free(domain->retired[i].block);
+    }
+
+    free(domain->retired);
+    free(domain->fresh);
+    free(domain->category_blocks.entries);
+    free(domain->subgroup_blocks.entries);
+    snapshot_domain_init(domain);
+}
+
+void snapshot_domain_memory(const SnapshotDomain* domain, size_t* used, size_t* reserved,
+                            long long* allocations) {
+    size_t bytes = 0;
+    long long blocks = 0;
+
+    Snapshot* current = domain ? atomic_load(&domain->current) : NULL;
+    if (current) {
+        bytes += sizeof(Snapshot) + current->category_count * sizeof(Category);
+        blocks++;
+
+        for (int i = 0; i < current->category_count; i++) {
+            SubgroupBlock* subgroups = subgroup_block_of(&current->categories[i]);
+            if (!subgroups) continue;
+
+            bytes += sizeof(SubgroupBlock) + subgroups->count * sizeof(Subgroup);
+            blocks++;
+            for (int j = 0; j < subgroups->count; j++) {
+                ProductBlock* products = product_block_of(&subgroups->items[j]);
+                if (!products) continue;
+
+                bytes += sizeof(ProductBlock) + products->count * sizeof(Product);
+                blocks++;
+            }
+        }
+    }
+
+    size_t bookkeeping = 0;
+    if (domain) {
+        bookkeeping = (size_t)domain->category_blocks.capacity * sizeof(BlockMapEntry) +
+                      (size_t)domain->subgroup_blocks.capacity * sizeof(BlockMapEntry) +
+                      domain->retired_capacity * sizeof(RetiredBlock) +
+                      domain->fresh_capacity * sizeof(void*);
+        blocks += (domain->category_blocks.entries != NULL) + (domain->subgroup_blocks.entries != NULL) +
+                  (domain->retired != NULL) + (domain->fresh != NULL);
+    }
+
+    *used = bytes;
+    *reserved = bytes + bookkeeping;
+    *allocations = blocks;
+}
@@ -7,6 +7,8 @@
  */
 
 #include "../include/subgroup.h"
+#include "../include/metrics.h"
+#include "../include/render.h"
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
@@ -66,7 +68,7 @@ Subgroup subgroup_create(int id, int category_id, const char* name, const char*
     return subgroup;
 }
 
-bool subgroup_add_product(Subgroup* subgroup, Product product) {
+static bool add_product(Subgroup* subgroup, Product product) {
     if (!subgroup) {
         fprintf(stderr, "Error: Subgroup pointer is NULL\n");
         return false;
@@ -98,10 +100,61 @@ bool subgroup_add_product(Subgroup* subgroup, Product product) {
     return true;
 }
 
+bool subgroup_add_product(Subgroup* subgroup, Product product) {
+    MetricTimer timer = METRICS_START();
+    bool ok = add_product(subgroup, product);
+    METRICS_STOP(METRIC_SUBGROUP_ADD_PRODUCT, timer, ok);
+    return ok;
+}
+
+bool subgroup_reserve(Subgroup* subgroup, int capacity) {
+    if (!subgroup) {
+        fprintf(stderr, "Error: Subgroup pointer is NULL\n");
+        return false;
+    }
+    
+    if (capacity <= subgroup->product_capacity) {
+        return true;
+    }
+    
+    // Keep doubling semantics so later single adds stay amortized O(1)
+    int new_capacity = subgroup->product_capacity * 2;
+    if (new_capacity < capacity) {
+        new_capacity = capacity;
+    }
+    
+    Product* new_products = (Product*)realloc(subgroup->products, new_capacity * sizeof(Product));
+    if (!new_products) {
+        fprintf(stderr, "Error: Failed to expand product array\n");
+        return false;
+    }
+    
+    subgroup->products = new_products;
+    subgroup->product_capacity = new_capacity;
+    return true;
+}
+
+size_t subgroup_shrink_to_fit(Subgroup* subgroup) {
+    if (!subgroup || !subgroup->products) return 0;
+    
+    int new_capacity = subgroup->product_count > INITIAL_PRODUCT_CAPACITY ?
+                       subgroup->product_count : INITIAL_PRODUCT_CAPACITY;
+    if (new_capacity >= subgroup->product_capacity) return 0;
+    
+    // A failed shrink leaves the old, larger array in place
+    Product* new_products = (Product*)realloc(subgroup->products, new_capacity * sizeof(Product));
+    if (!new_products) return 0;
+    
+    size_t released = (size_t)(subgroup->product_capacity - new_capacity) * sizeof(Product);
+    subgroup->products = new_products;
+    subgroup->product_capacity = new_capacity;
+    return released;
+}
+
 /**
  * ✅ FIXED: Use swap-and-pop method for O(1) removal
  */
-bool subgroup_remove_product(Subgroup* subgroup, int product_id) {
+static bool remove_product(Subgroup* subgroup, int product_id) {
     if (!subgroup) {
         fprintf(stderr, "Error: Subgroup pointer is NULL\n");
         return false;
@@ -137,7 +190,14 @@ bool subgroup_remove_product(Subgroup* subgroup, int product_id) {
     return true;
 }
 
-Product* subgroup_find_product_by_id(Subgroup* subgroup, int product_id) {
+bool subgroup_remove_product(Subgroup* subgroup, int product_id) {
+    MetricTimer timer = METRICS_START();
+    bool ok = remove_product(subgroup, product_id);
+    METRICS_STOP(METRIC_SUBGROUP_REMOVE_PRODUCT, timer, ok);
+    return ok;
+}
+
+static Product* find_product_by_id(Subgroup* subgroup, int product_id) {
     if (!subgroup) {
         return NULL;
     }
@@ -151,53 +211,62 @@ Product* subgroup_find_product_by_id(Subgroup* subgroup, int product_id) {
     return NULL;
 }
 
+Product* subgroup_find_product_by_id(Subgroup* subgroup, int product_id) {
+    MetricTimer timer = METRICS_START();
+    Product* found = find_product_by_id(subgroup, product_id);
+    METRICS_STOP(METRIC_SUBGROUP_FIND_PRODUCT, timer, found != NULL);
+    return found;
+}
+
 void subgroup_display(const Subgroup* subgroup) {
     if (!subgroup) {
-        printf("Error: Subgroup pointer is NULL\n");
+        render_printf("Error: Subgroup pointer is NULL\n");
         return;
     }
     
-    printf("\n╔══════════════════════════════════════════════════════════╗\n");
-    printf(  "║  Subgroup Information                                    ║\n");
-    printf(  "╚══════════════════════════════════════════════════════════╝\n");
-    printf("  ID:          %d\n", subgroup->id);
-    printf("  Category ID: %d\n", subgroup->category_id);
-    printf("  Name:        %s\n", subgroup->name);
-    printf("  Description: %s\n", subgroup->description);
-    printf("  Products:    %d (Capacity: %d)\n", subgroup->product_count, subgroup->product_capacity);
+    render_begin();
+    render_printf("\n╔══════════════════════════════════════════════════════════╗\n");
+    render_printf(  "║  Subgroup Information                                    ║\n");
+    render_printf(  "╚══════════════════════════════════════════════════════════╝\n");
+    render_printf("  ID:          %d\n", subgroup->id);
+    render_printf("  Category ID: %d\n", subgroup->category_id);
+    render_printf("  Name:        %s\n", subgroup->name);
+    render_printf("  Description: %s\n", subgroup->description);
+    render_printf("  Products:    %d (Capacity: %d)\n", subgroup->product_count, subgroup->product_capacity);
     
     if (subgroup->product_count > 0) {
-        printf("\n  Products in this subgroup:\n");
+        render_printf("\n  Products in this subgroup:\n");
         product_display_table_header();
         for (int i = 0; i < subgroup->product_count; i++) {
             product_display_table_row(&subgroup->products[i]);
         }
         product_display_table_footer();
     }
-    printf("\n");
+    render_printf("\n");
+    render_end();
 }
 
 void subgroup_display_table_header(void) {
-    printf("  ┌────────┬──────────────┬──────────────────────────────────────┬──────────┐\n");
-    printf("  │   ID   │ Category ID  │ Subgroup Name                        │ Products │\n");
-    printf("  ├────────┼──────────────┼──────────────────────────────────────┼──────────┤\n");
+    render_printf("  ┌────────┬──────────────┬──────────────────────────────────────┬──────────┐\n");
+    render_printf("  │   ID   │ Category ID  │ Subgroup Name                        │ Products │\n");
+    render_printf("  ├────────┼──────────────┼──────────────────────────────────────┼──────────┤\n");
 }
 
 void subgroup_display_table_row(const Subgroup* subgroup) {
     if (!subgroup) return;
 
-    printf("  │ %-6d │ %-12d │ %-36s │ %-8d │\n",
-           subgroup->id,
-           subgroup->category_id,
-           subgroup->name,
-           subgroup->product_count);
+    render_printf("  │ %-6d │ %-12d │ %-36s │ %-8d │\n",
+                  subgroup->id,
+                  subgroup->category_id,
+                  subgroup->name,
+                  subgroup->product_count);
 }
 
 void subgroup_display_table_footer(void) {
-    printf("  └────────┴──────────────┴──────────────────────────────────────┴──────────┘\n");
+    render_printf("  └────────┴──────────────┴──────────────────────────────────────┴──────────┘\n");
 }
 
-bool subgroup_update_name(Subgroup* subgroup, const char* name) {
+static bool update_name(Subgroup* subgroup, const char* name) {
     if (!subgroup) {
         fprintf(stderr, "Error: Subgroup pointer is NULL\n");
         return false;
@@ -220,7 +289,14 @@ bool subgroup_update_name(Subgroup* subgroup, const char* name) {
     return true;
 }
 
-bool subgroup_update_description(Subgroup* subgroup, const char* description) {
+bool subgroup_update_name(Subgroup* subgroup, const char* name) {
+    MetricTimer timer = METRICS_START();
+    bool ok = update_name(subgroup, name);
+    METRICS_STOP(METRIC_SUBGROUP_UPDATE_NAME, timer, ok);
+    return ok;
+}
+
+static bool update_description(Subgroup* subgroup, const char* description) {
     if (!subgroup) {
         fprintf(stderr, "Error: Subgroup pointer is NULL\n");
         return false;
@@ -237,6 +313,13 @@ bool subgroup_update_description(Subgroup* subgroup, const char* description) {
     return true;
 }
 
+bool subgroup_update_description(Subgroup* subgroup, const char* description) {
+    MetricTimer timer = METRICS_START();
+    bool ok = update_description(subgroup, description);
+    METRICS_STOP(METRIC_SUBGROUP_UPDATE_DESCRIPTION, timer, ok);
+    return ok;
+}
+
 bool subgroup_is_valid(const Subgroup* subgroup) {
     if (!subgroup) {
         return false;
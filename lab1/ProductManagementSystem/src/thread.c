@@ -0,0 +1,164 @@
+/**
+ * @file thread.c
+ * @brief Portable threading primitives implementation
+ * @author PMS Team
+ * @date 2025
+ * @compatible Dev-C++ 6.3, TDM-GCC 9.2.0, C11
+ */
+
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L    // sysconf, pthread_rwlock_t under -std=c11
+#endif
+
+#include "../include/thread.h"
+#include <stdlib.h>
+#include <stdio.h>
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+/**
+ * @brief Heap-allocated start block, freed by the new thread
+ */
+typedef struct {
+    ThreadFunc func;
+    void* arg;
+} ThreadStart;
+
+#ifdef _WIN32
+
+static DWORD WINAPI thread_entry(LPVOID param) {
+    ThreadStart start = *(ThreadStart*)param;
+    free(param);
+    start.func(start.arg);
+    return 0;
+}
+
+bool thread_create(Thread* thread, ThreadFunc func, void* arg) {
+    ThreadStart* start = (ThreadStart*)malloc(sizeof(ThreadStart));
+    if (!start) {
+        fprintf(stderr, "Error: Failed to allocate thread start block\n");
+        return false;
+    }
+    start->func = func;
+    start->arg = arg;
+
+    *thread = CreateThread(NULL, 0, thread_entry, start, 0, NULL);
+    if (!*thread) {
+        fprintf(stderr, "Error: Failed to create thread\n");
+        free(start);
+        return false;
+    }
+    return true;
+}
+
+void thread_join(Thread thread) {
+    WaitForSingleObject(thread, INFINITE);
+    CloseHandle(thread);
+}
+
+int thread_cpu_count(void) {
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors > 0 ? (int)info.dwNumberOfProcessors : 1;
+}
+
+void mutex_init(Mutex* mutex)    { InitializeCriticalSection(mutex); }
+void mutex_destroy(Mutex* mutex) { DeleteCriticalSection(mutex); }
+void mutex_lock(Mutex* mutex)    { EnterCriticalSection(mutex); }
+void mutex_unlock(Mutex* mutex)  { LeaveCriticalSection(mutex); }
+bool mutex_trylock(Mutex* mutex) { return TryEnterCriticalSection(mutex) != 0; }
+
+void cond_init(CondVar* cond)                { InitializeConditionVariable(cond); }
+void cond_destroy(CondVar* cond)             { (void)cond; }
+void cond_wait(CondVar* cond, Mutex* mutex)  { SleepConditionVariableCS(cond, mutex, INFINITE); }
+void cond_signal(CondVar* cond)              { WakeConditionVariable(cond); }
+void cond_broadcast(CondVar* cond)           { WakeAllConditionVariable(cond); }
+
+void rwlock_init(RwLock* lock)         { InitializeSRWLock(lock); }
+void rwlock_destroy(RwLock* lock)      { (void)lock; }
+void rwlock_read_lock(RwLock* lock)    { AcquireSRWLockShared(lock); }
+void rwlock_read_unlock(RwLock* lock)  { ReleaseSRWLockShared(lock); }
+void rwlock_write_lock(RwLock* lock)   { AcquireSRWLockExclusive(lock); }
+void rwlock_write_unlock(RwLock* lock) { ReleaseSRWLockExclusive(lock); }
+
+#else
+
+static void* thread_entry(void* param) {
+    ThreadStart start = *(ThreadStart*)param;
+    free(param);
+    start.func(start.arg);
+    return NULL;
+}
+
+bool thread_create(Thread* thread, ThreadFunc func, void* arg) {
+    ThreadStart* start = (ThreadStart*)malloc(sizeof(ThreadStart));
+    if (!start) {
+        fprintf(stderr, "Error: Failed to allocate thread start block\n");
+        return false;
+    }
+    start->func = func;
+    start->arg = arg;
+
+    if (pthread_create(thread, NULL, thread_entry, start) != 0) {
+        fprintf(stderr, "Error: Failed to create thread\n");
+        free(start);
+        return false;
+    }
+    return true;
+}
+
+void thread_join(Thread thread) {
+    pthread_join(thread, NULL);
+}
+
+int thread_cpu_count(void) {
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? (int)count : 1;
+}
+
+void mutex_init(Mutex* mutex)    { pthread_mutex_init(mutex, NULL); }
+void mutex_destroy(Mutex* mutex) { pthread_mutex_destroy(mutex); }
+void mutex_lock(Mutex* mutex)    { pthread_mutex_lock(mutex); }
+void mutex_unlock(Mutex* mutex)  { pthread_mutex_unlock(mutex); }
+bool mutex_trylock(Mutex* mutex) { return pthread_mutex_trylock(mutex) == 0; }
+
+void cond_init(CondVar* cond)                { pthread_cond_init(cond, NULL); }
+void cond_destroy(CondVar* cond)             { pthread_cond_destroy(cond); }
+void cond_wait(CondVar* cond, Mutex* mutex)  { pthread_cond_wait(cond, mutex); }
+void cond_signal(CondVar* cond)              { pthread_cond_signal(cond); }
+void cond_broadcast(CondVar* cond)           { pthread_cond_broadcast(cond); }
+
+void rwlock_init(RwLock* lock) {
+    pthread_rwlock_init(&lock->lock, NULL);
+    pthread_mutex_init(&lock->turnstile, NULL);
+}
+
+void rwlock_destroy(RwLock* lock) {
+    pthread_mutex_destroy(&lock->turnstile);
+    pthread_rwlock_destroy(&lock->lock);
+}
+
+void rwlock_read_lock(RwLock* lock) {
+    pthread_mutex_lock(&lock->turnstile);
+    pthread_rwlock_rdlock(&lock->lock);
+    pthread_mutex_unlock(&lock->turnstile);
+}
+
+void rwlock_read_unlock(RwLock* lock) {
+    pthread_rwlock_unlock(&lock->lock);
+}
+
+void rwlock_write_lock(RwLock* lock) {
+    // Holding the turnstile while readers drain keeps new ones from joining them
+    pthread_mutex_lock(&lock->turnstile);
+    pthread_rwlock_wrlock(&lock->lock);
+    pthread_mutex_unlock(&lock->turnstile);
+}
+
+void rwlock_write_unlock(RwLock* lock) {
+    pthread_rwlock_unlock(&lock->lock);
+}
+
+#endif
@@ -0,0 +1,140 @@
+/**
+ * @file thread_pool.c
+ * @brief Worker pool implementation
+ * @author PMS Team
+ * @date 2025
+ * @compatible Dev-C++ 6.3, TDM-GCC 9.2.0, C11
+ */
+
+#include "../include/thread_pool.h"
+#include <stdlib.h>
+#include <stdio.h>
+
+/**
+ * @brief Claim and run tasks of the current job until none are left
+ *
+ * Called with pool->lock held; returns with it held.
+ */
+static void run_pending_tasks(ThreadPool* pool) {
+    while (pool->next_task < pool->task_count) {
+        int index = pool->next_task++;
+        ThreadTask task = pool->task;
+        void* context = pool->context;
+
+        mutex_unlock(&pool->lock);
+        task(context, index);
+        mutex_lock(&pool->lock);
+
+        pool->pending_tasks--;
+        if (pool->pending_tasks == 0) {
+            cond_broadcast(&pool->work_done);
+        }
+    }
+}
+
+static void worker_main(void* arg) {
+    ThreadPool* pool = (ThreadPool*)arg;
+    unsigned long seen_generation = 0;
+
+    mutex_lock(&pool->lock);
+    while (true) {
+        while (!pool->stopping && pool->job_generation == seen_generation) {
+            cond_wait(&pool->work_ready, &pool->lock);
+        }
+        if (pool->stopping) break;
+
+        seen_generation = pool->job_generation;
+        run_pending_tasks(pool);
+    }
+    mutex_unlock(&pool->lock);
+}
+
+ThreadPool* thread_pool_create(int thread_count) {
+    if (thread_count <= 0) {
+        thread_count = thread_cpu_count();
+    }
+
+    ThreadPool* pool = (ThreadPool*)calloc(1, sizeof(ThreadPool));
+    if (!pool) {
+        fprintf(stderr, "Error: Failed to allocate thread pool\n");
+        return NULL;
+    }
+
+    mutex_init(&pool->lock);
+    mutex_init(&pool->run_lock);
+    cond_init(&pool->work_ready);
+    cond_init(&pool->work_done);
+    pool->thread_count = 1;
+
+    if (thread_count > 1) {
+        pool->threads = (Thread*)malloc((thread_count - 1) * sizeof(Thread));
+        if (!pool->threads) {
+            fprintf(stderr, "Error: Failed to allocate worker threads\n");
+            thread_pool_destroy(pool);
+            return NULL;
+        }
+
+        // A pool with fewer workers than asked for still works
+        for (int i = 0; i < thread_count - 1; i++) {
+            if (!thread_create(&pool->threads[i], worker_main, pool)) break;
+            pool->thread_count++;
+        }
+    }
+
+    return pool;
+}
+
+void thread_pool_destroy(ThreadPool* pool) {
+    if (!pool) return;
+
+    mutex_lock(&pool->lock);
+    pool->stopping = true;
+    cond_broadcast(&pool->work_ready);
+    mutex_unlock(&pool->lock);
+
+    for (int i = 0; i < pool->thread_count - 1; i++) {
+        thread_join(pool->threads[i]);
+    }
+
+    free(pool->threads);
+    cond_destroy(&pool->work_done);
+    cond_destroy(&pool->work_ready);
+    mutex_destroy(&pool->run_lock);
+    mutex_destroy(&pool->lock);
+    free(pool);
+}
+
+void thread_pool_run(ThreadPool* pool, ThreadTask task, void* context, int task_count) {
+    if (!task || task_count <= 0) return;
+
+    // Another thread owns the workers right now; do the job here instead of queueing
+    if (!pool || pool->thread_count <= 1 || !mutex_trylock(&pool->run_lock)) {
+        for (int i = 0; i < task_count; i++) {
+            task(context, i);
+        }
+        return;
+    }
+
+    mutex_lock(&pool->lock);
+
+    pool->task = task;
+    pool->context = context;
+    pool->task_count = task_count;
+    pool->next_task = 0;
+    pool->pending_tasks = task_count;
+    pool->job_generation++;
+    cond_broadcast(&pool->work_ready);
+
+    // Help out, then wait for tasks still running on workers
+    run_pending_tasks(pool);
+    while (pool->pending_tasks > 0) {
+        cond_wait(&pool->work_done, &pool->lock);
+    }
+
+    mutex_unlock(&pool->lock);
+    mutex_unlock(&pool->run_lock);
+}
+
+int thread_pool_size(const ThreadPool* pool) {
+    return pool ? pool->thread_count : 1;
+}
@@ -0,0 +1,53 @@
+/**
+ * @file timestamp.c
+ * @brief Cached wall-clock timestamps implementation
+ * @author PMS Team
+ * @date 2025
+ * @compatible Dev-C++ 6.3, TDM-GCC 9.2.0, C11
+ */
+
+#if defined(_WIN32) && !defined(MINGW_HAS_SECURE_API)
+#define MINGW_HAS_SECURE_API 1     // Declares localtime_s in older MinGW headers
+#endif
+
+#include "../include/timestamp.h"
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+
+typedef struct {
+    time_t second;             // Second the text was formatted for
+    char text[TIMESTAMP_SIZE];
+    int valid;
+} TimestampCache;
+
+static _Thread_local TimestampCache cache;
+
+/**
+ * @brief Convert to local time into the caller's struct
+ * @return false if the time cannot be represented
+ */
+static bool to_local_time(time_t second, struct tm* out) {
+    #ifdef _WIN32
+    return localtime_s(out, &second) == 0;
+    #else
+    return localtime_r(&second, out) != NULL;
+    #endif
+}
+
+void timestamp_now(char* buffer, size_t size) {
+    if (!buffer || size < TIMESTAMP_SIZE) return;
+
+    time_t now = time(NULL);
+    if (!cache.valid || now != cache.second) {
+        struct tm local;
+        if (!to_local_time(now, &local)) {
+            buffer[0] = '\0';
+            return;
+        }
+        strftime(cache.text, sizeof(cache.text), "%Y-%m-%d %H:%M:%S", &local);
+        cache.second = now;
+        cache.valid = 1;
+    }
+    memcpy(buffer, cache.text, TIMESTAMP_SIZE);
+}
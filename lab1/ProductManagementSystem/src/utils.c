@@ -7,40 +7,77 @@
  */
 
 #include "../include/utils.h"
+#include "../include/simd_filter.h"
+#include "../include/metrics.h"
+#include "../include/render.h"
+#include "../include/timestamp.h"
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
 #include <stdbool.h>
-#include <time.h>
 #include <ctype.h>
+#include <limits.h>
+
+#if defined(__GLIBC__)
+#include <malloc.h>            // malloc_trim
+#endif
 
 #ifdef _WIN32
 #include <windows.h>
 #endif
 
 #define INITIAL_CATEGORY_CAPACITY 10
+#define PARALLEL_SCAN_MIN_PRODUCTS 32768   // Below this, thread hand-off costs more than it saves
+#define STATISTICS_CHUNK_PRODUCTS 16384    // Fixed so totals do not depend on the thread count
+#define INITIAL_BATCH_CAPACITY 64
+#define INITIAL_UNDO_CAPACITY 16
 #define DATA_FILE "data/products.dat"
-#define BACKUP_FILE "data/products.bak"
 
 // ============================================================================
 // Color Functions
 // ============================================================================
 
+static const char* ansi_color(ConsoleColor color) {
+    switch(color) {
+        case COLOR_RESET:   return "\033[0m";
+        case COLOR_HEADER:  return "\033[1;36m";
+        case COLOR_SUCCESS: return "\033[1;32m";
+        case COLOR_ERROR:   return "\033[1;31m";
+        case COLOR_WARNING: return "\033[1;33m";
+        case COLOR_INPUT:   return "\033[1;37m";
+        case COLOR_INFO:    return "\033[1;34m";
+    }
+    return "\033[0m";
+}
+
 void set_color(ConsoleColor color) {
+    // Escape sequences travel inside a render block's buffer; a console API call cannot
+    if (render_ansi_supported()) {
+        const char* code = ansi_color(color);
+        render_write(code, strlen(code));
+        return;
+    }
     #ifdef _WIN32
+    render_flush();
     HANDLE hConsole = GetStdHandle(STD_OUTPUT_HANDLE);
     SetConsoleTextAttribute(hConsole, color);
-    #else
-    // For non-Windows systems, use ANSI codes
-    switch(color) {
-        case COLOR_RESET:   printf("\033[0m"); break;
-        case COLOR_HEADER:  printf("\033[1;36m"); break;
-        case COLOR_SUCCESS: printf("\033[1;32m"); break;
-        case COLOR_ERROR:   printf("\033[1;31m"); break;
-        case COLOR_WARNING: printf("\033[1;33m"); break;
-        case COLOR_INPUT:   printf("\033[1;37m"); break;
-        case COLOR_INFO:    printf("\033[1;34m"); break;
+    #endif
+}
+
+void set_stream_color(FILE* stream, ConsoleColor color) {
+    if (stream != stderr) {
+        set_color(color);
+        return;
     }
+    
+    // stderr bypasses the render buffer, so write out what stdout holds first
+    render_flush();
+    #ifdef _WIN32
+    // Attributes belong to the console, so this colors stderr whether or not
+    // it understands escape sequences; a redirected handle just ignores it
+    SetConsoleTextAttribute(GetStdHandle(STD_ERROR_HANDLE), color);
+    #else
+    fputs(ansi_color(color), stderr);
     #endif
 }
 
@@ -71,20 +108,11 @@ void trim_string(char* str) {
 }
 
 void get_current_timestamp(char* buffer, size_t size) {
-    if (!buffer || size < 20) return;
-    
-    time_t now = time(NULL);
-    struct tm* tm_info = localtime(&now);
-    
-    strftime(buffer, size, "%Y-%m-%d %H:%M:%S", tm_info);
+    timestamp_now(buffer, size);
 }
 
 void clear_screen(void) {
-    #ifdef _WIN32
-    system("cls");
-    #else
-    system("clear");
-    #endif
+    render_clear_screen();
 }
 
 void pause_screen(void) {
@@ -147,9 +175,9 @@ bool safe_input_int(const char* prompt, int* value) {
     long result = strtol(buffer, &endptr, 10);
     
     if (*endptr != '\0' || endptr == buffer) {
-        set_color(COLOR_ERROR);
+        set_stream_color(stderr, COLOR_ERROR);
         fprintf(stderr, "✗ Error: Invalid integer input\n");
-        set_color(COLOR_RESET);
+        set_stream_color(stderr, COLOR_RESET);
         return false;
     }
     
@@ -175,9 +203,9 @@ bool safe_input_float(const char* prompt, float* value) {
     float result = strtof(buffer, &endptr);
     
     if (*endptr != '\0' || endptr == buffer) {
-        set_color(COLOR_ERROR);
+        set_stream_color(stderr, COLOR_ERROR);
         fprintf(stderr, "✗ Error: Invalid float input\n");
-        set_color(COLOR_RESET);
+        set_stream_color(stderr, COLOR_RESET);
         return false;
     }
     
@@ -185,6 +213,146 @@ bool safe_input_float(const char* prompt, float* value) {
     return true;
 }
 
+// ============================================================================
+// Handle Maintenance
+// ============================================================================
+
+/**
+ * @brief Register a product and add its scan table row
+ * @return Slot index, or HANDLE_INVALID_INDEX on failure
+ */
+static int acquire_product_handle(DataStore* store, const Product* product, int sub_slot, int index) {
+    int slot = handle_table_acquire(&store->product_handles, product->id, sub_slot, index);
+    if (slot != HANDLE_INVALID_INDEX) {
+        product_table_insert(&store->scan_table, slot, product);
+    }
+    return slot;
+}
+
+/**
+ * @brief Drop a product's scan table row and release its handle
+ */
+static void release_product_handle(DataStore* store, int product_id) {
+    product_table_remove(&store->scan_table, handle_table_slot_of(&store->product_handles, product_id));
+    handle_table_release(&store->product_handles, product_id);
+}
+
+/**
+ * @brief Rewrite a product's scan table row after its fields changed
+ */
+static void refresh_product_row(DataStore* store, const Product* product) {
+    product_table_update(&store->scan_table, handle_table_slot_of(&store->product_handles, product->id), product);
+}
+
+/**
+ * @brief Grow the handle tables so registering a subgroup and its products cannot fail
+ */
+/**
+ * @brief Check that no ID in a subgroup (or its products) is registered yet
+ *
+ * Registering a taken ID would repoint the existing slot at the new entity
+ * and leave the old one unreachable.
+ */
+static bool subgroup_ids_free(DataStore* store, const Subgroup* sub) {
+    if (handle_table_slot_of(&store->subgroup_handles, sub->id) != HANDLE_INVALID_INDEX) {
+        fprintf(stderr, "Error: Subgroup ID %d already exists\n", sub->id);
+        return false;
+    }
+    
+    for (int k = 0; k < sub->product_count; k++) {
+        if (handle_table_slot_of(&store->product_handles, sub->products[k].id) != HANDLE_INVALID_INDEX) {
+            fprintf(stderr, "Error: Product ID %d already exists\n", sub->products[k].id);
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool category_ids_free(DataStore* store, const Category* cat) {
+    if (handle_table_slot_of(&store->category_handles, cat->id) != HANDLE_INVALID_INDEX) {
+        fprintf(stderr, "Error: Category ID %d already exists\n", cat->id);
+        return false;
+    }
+    
+    for (int j = 0; j < cat->subgroup_count; j++) {
+        if (!subgroup_ids_free(store, &cat->subgroups[j])) return false;
+    }
+    return true;
+}
+
+static bool reserve_subgroup_handles(DataStore* store, const Subgroup* sub) {
+    return handle_table_reserve(&store->subgroup_handles, 1) &&
+           handle_table_reserve(&store->product_handles, sub->product_count);
+}
+
+/**
+ * @brief Grow the handle tables so registering a whole category cannot fail
+ */
+static bool reserve_category_handles(DataStore* store, const Category* cat) {
+    int products = 0;
+    for (int j = 0; j < cat->subgroup_count; j++) {
+        products += cat->subgroups[j].product_count;
+    }
+    
+    return handle_table_reserve(&store->category_handles, 1) &&
+           handle_table_reserve(&store->subgroup_handles, cat->subgroup_count) &&
+           handle_table_reserve(&store->product_handles, products);
+}
+
+/**
+ * @return true if every handle was registered
+ */
+static bool register_subgroup_handles(DataStore* store, int category_slot, Subgroup* sub, int sub_index) {
+    int sub_slot = handle_table_acquire(&store->subgroup_handles, sub->id, category_slot, sub_index);
+    bool ok = sub_slot != HANDLE_INVALID_INDEX;
+    
+    for (int k = 0; k < sub->product_count; k++) {
+        ok = acquire_product_handle(store, &sub->products[k], sub_slot, k) != HANDLE_INVALID_INDEX && ok;
+    }
+    return ok;
+}
+
+/**
+ * @return true if every handle was registered
+ */
+static bool register_category_handles(DataStore* store, int cat_index) {
+    Category* cat = &store->categories[cat_index];
+    int cat_slot = handle_table_acquire(&store->category_handles, cat->id, HANDLE_INVALID_INDEX, cat_index);
+    bool ok = cat_slot != HANDLE_INVALID_INDEX;
+    
+    for (int j = 0; j < cat->subgroup_count; j++) {
+        ok = register_subgroup_handles(store, cat_slot, &cat->subgroups[j], j) && ok;
+    }
+    return ok;
+}
+
+static void release_subgroup_handles(DataStore* store, const Subgroup* sub) {
+    for (int k = 0; k < sub->product_count; k++) {
+        release_product_handle(store, sub->products[k].id);
+    }
+    handle_table_release(&store->subgroup_handles, sub->id);
+}
+
+static void release_category_handles(DataStore* store, const Category* cat) {
+    for (int j = 0; j < cat->subgroup_count; j++) {
+        release_subgroup_handles(store, &cat->subgroups[j]);
+    }
+    handle_table_release(&store->category_handles, cat->id);
+}
+
+void datastore_rebuild_handles(DataStore* store) {
+    if (!store) return;
+    
+    handle_table_clear(&store->category_handles);
+    handle_table_clear(&store->subgroup_handles);
+    handle_table_clear(&store->product_handles);
+    store->scan_table.is_built = false;    // Rows refer to the old slots
+    
+    for (int i = 0; i < store->category_count; i++) {
+        register_category_handles(store, i);
+    }
+}
+
 // ============================================================================
 // DataStore Management
 // ============================================================================
@@ -194,11 +362,23 @@ DataStore datastore_init(void) {
     
     store.category_count = 0;
     store.category_capacity = INITIAL_CATEGORY_CAPACITY;
-    store.next_category_id = 1;
-    store.next_subgroup_id = 1;
-    store.next_product_id = 1;
+    atomic_init(&store.next_category_id, 1);
+    atomic_init(&store.next_subgroup_id, 1);
+    atomic_init(&store.next_product_id, 1);
     store.is_modified = false;
     strcpy(store.last_saved, "Never");
+    store.version = 1;
+    
+    handle_table_init(&store.category_handles);
+    handle_table_init(&store.subgroup_handles);
+    handle_table_init(&store.product_handles);
+    product_table_init(&store.scan_table);
+    store.pool = NULL;
+    store.lock = NULL;
+    store.snapshots = NULL;
+    store.txn = NULL;
+    store.quiet = false;
+    store.ids_striped = false;
     
     // Allocate initial category array
     store.categories = (Category*)malloc(INITIAL_CATEGORY_CAPACITY * sizeof(Category));
@@ -210,9 +390,10 @@ DataStore datastore_init(void) {
     return store;
 }
 
-void datastore_free(DataStore* store) {
-    if (!store) return;
-    
+/**
+ * @brief Free the hierarchy, indexes and scan table, keeping pool and locks
+ */
+static void datastore_free_data(DataStore* store) {
     // Free all categories (which will cascade to subgroups and products)
     if (store->categories) {
         for (int i = 0; i < store->category_count; i++) {
@@ -224,9 +405,266 @@ void datastore_free(DataStore* store) {
     
     store->category_count = 0;
     store->category_capacity = 0;
+    
+    handle_table_free(&store->category_handles);
+    handle_table_free(&store->subgroup_handles);
+    handle_table_free(&store->product_handles);
+    product_table_free(&store->scan_table);
 }
 
-bool datastore_add_category(DataStore* store, Category category) {
+void datastore_free(DataStore* store) {
+    if (!store) return;
+    
+    datastore_free_data(store);
+    
+    thread_pool_destroy(store->pool);
+    store->pool = NULL;
+    
+    if (store->snapshots) {
+        snapshot_domain_free(store->snapshots);
+        free(store->snapshots);
+        store->snapshots = NULL;
+    }
+    
+    if (store->lock) {
+        mutex_destroy(&store->lock->save_lock);
+        mutex_destroy(&store->lock->scan_lock);
+        rwlock_destroy(&store->lock->rwlock);
+        free(store->lock);
+        store->lock = NULL;
+    }
+}
+
+bool datastore_set_thread_count(DataStore* store, int thread_count) {
+    if (!store) {
+        fprintf(stderr, "Error: DataStore pointer is NULL\n");
+        return false;
+    }
+    
+    datastore_write_lock(store);
+    thread_pool_destroy(store->pool);
+    store->pool = NULL;
+    
+    if (thread_count != 1) {
+        store->pool = thread_pool_create(thread_count);
+    }
+    datastore_write_unlock(store);
+    
+    return thread_count == 1 || store->pool != NULL;
+}
+
+/**
+ * @brief Publish the current state to snapshot readers, if enabled
+ */
+static void publish_snapshot(DataStore* store) {
+    if (!store->snapshots) return;
+    
+    SnapshotInfo info;
+    info.version = store->version;
+    info.next_category_id = atomic_load(&store->next_category_id);
+    info.next_subgroup_id = atomic_load(&store->next_subgroup_id);
+    info.next_product_id = atomic_load(&store->next_product_id);
+    info.is_modified = store->is_modified;
+    memcpy(info.last_saved, store->last_saved, sizeof(info.last_saved));
+    
+    // On failure readers keep seeing the previous version
+    snapshot_publish(store->snapshots, &info, store->categories, store->category_count);
+}
+
+/**
+ * @brief Record a change made by a datastore_* mutation
+ * @param category_id Category whose subgroup array changed, 0 for none
+ * @param subgroup_id Subgroup whose product array changed, 0 for none
+ */
+static void store_changed(DataStore* store, int category_id, int subgroup_id) {
+    store->is_modified = true;
+    store->version++;
+    
+    if (store->snapshots) {
+        snapshot_invalidate(store->snapshots, category_id, subgroup_id);
+        
+        // Uncommitted changes stay invisible; commit/abort publish once
+        if (!store->txn) {
+            publish_snapshot(store);
+        }
+    }
+}
+
+static atomic_int* id_counter(DataStore* store, IdKind kind) {
+    switch (kind) {
+        case ID_CATEGORY: return &store->next_category_id;
+        case ID_SUBGROUP: return &store->next_subgroup_id;
+        case ID_PRODUCT:  return &store->next_product_id;
+    }
+    return NULL;
+}
+
+/**
+ * @brief Move the counter past an ID the caller chose, so it is never allocated again
+ */
+static void claim_id(DataStore* store, IdKind kind, int id) {
+    atomic_int* counter = id_counter(store, kind);
+    int next = atomic_load(counter);
+    
+    // Lock-free maximum; a failed exchange reloads next
+    while (next <= id && id < INT_MAX &&
+           !atomic_compare_exchange_weak(counter, &next, id + 1)) {
+    }
+}
+
+/**
+ * @brief Make room for one undo record, if a transaction is open
+ *
+ * Mutators call this before changing anything so logging cannot fail afterwards.
+ */
+static bool txn_reserve(DataStore* store) {
+    DataStoreTxn* txn = store->txn;
+    if (!txn || txn->record_count < txn->record_capacity) return true;
+    
+    int new_capacity = txn->record_capacity > 0 ? txn->record_capacity * 2 : INITIAL_UNDO_CAPACITY;
+    UndoRecord* new_records = (UndoRecord*)realloc(txn->records, new_capacity * sizeof(UndoRecord));
+    if (!new_records) {
+        fprintf(stderr, "Error: Failed to expand undo log\n");
+        return false;
+    }
+    
+    txn->records = new_records;
+    txn->record_capacity = new_capacity;
+    return true;
+}
+
+/**
+ * @brief Append an undo record to the open transaction
+ * @return Record to fill in, NULL outside a transaction
+ */
+static UndoRecord* txn_log(DataStore* store, UndoKind kind, int owner_id, int index) {
+    DataStoreTxn* txn = store->txn;
+    if (!txn) return NULL;
+    
+    UndoRecord* record = &txn->records[txn->record_count++];
+    record->kind = kind;
+    record->owner_id = owner_id;
+    record->index = index;
+    return record;
+}
+
+void datastore_mark_modified(DataStore* store) {
+    if (!store) return;
+    
+    MetricTimer timer = METRICS_START();
+    store->is_modified = true;
+    store->version++;
+    
+    // Any product may have changed or moved, so no single row can be patched
+    store->scan_table.is_built = false;
+    
+    // The caller changed something in place, so compare instead of trusting reuse
+    if (store->snapshots) {
+        snapshot_invalidate_all(store->snapshots);
+        publish_snapshot(store);
+    }
+    METRICS_STOP(METRIC_DATASTORE_MARK_MODIFIED, timer, true);
+}
+
+// ============================================================================
+// Concurrency
+// ============================================================================
+
+bool datastore_enable_concurrency(DataStore* store) {
+    if (!store) {
+        fprintf(stderr, "Error: DataStore pointer is NULL\n");
+        return false;
+    }
+    
+    if (store->lock) return true;
+    
+    DataStoreLock* lock = (DataStoreLock*)malloc(sizeof(DataStoreLock));
+    if (!lock) {
+        fprintf(stderr, "Error: Failed to allocate datastore lock\n");
+        return false;
+    }
+    
+    rwlock_init(&lock->rwlock);
+    mutex_init(&lock->scan_lock);
+    mutex_init(&lock->save_lock);
+    store->lock = lock;
+    return true;
+}
+
+bool datastore_enable_snapshots(DataStore* store) {
+    if (!store) {
+        fprintf(stderr, "Error: DataStore pointer is NULL\n");
+        return false;
+    }
+    
+    if (store->snapshots) return true;
+    
+    // Writers still serialize among themselves on the exclusive lock
+    if (!datastore_enable_concurrency(store)) return false;
+    
+    SnapshotDomain* domain = (SnapshotDomain*)malloc(sizeof(SnapshotDomain));
+    if (!domain) {
+        fprintf(stderr, "Error: Failed to allocate snapshot domain\n");
+        return false;
+    }
+    snapshot_domain_init(domain);
+    
+    datastore_write_lock(store);
+    store->snapshots = domain;
+    publish_snapshot(store);
+    datastore_write_unlock(store);
+    
+    return atomic_load(&domain->current) != NULL;
+}
+
+bool datastore_snapshot_pin(DataStore* store, SnapshotPin* pin) {
+    if (!store || !store->snapshots || !snapshot_pin(store->snapshots, pin)) return false;
+    
+    if (!pin->snapshot) {
+        snapshot_unpin(store->snapshots, pin);
+        return false;
+    }
+    return true;
+}
+
+void datastore_snapshot_unpin(DataStore* store, SnapshotPin* pin) {
+    if (store) snapshot_unpin(store->snapshots, pin);
+}
+
+void datastore_read_lock(DataStore* store) {
+    if (store && store->lock) rwlock_read_lock(&store->lock->rwlock);
+}
+
+void datastore_read_unlock(DataStore* store) {
+    if (store && store->lock) rwlock_read_unlock(&store->lock->rwlock);
+}
+
+void datastore_write_lock(DataStore* store) {
+    if (store && store->lock) rwlock_write_lock(&store->lock->rwlock);
+}
+
+void datastore_write_unlock(DataStore* store) {
+    if (store && store->lock) rwlock_write_unlock(&store->lock->rwlock);
+}
+
+const ProductTable* datastore_get_product_table(DataStore* store) {
+    if (!store) return NULL;
+    
+    // Readers share the store, so two of them may find the table stale at once
+    if (store->lock) mutex_lock(&store->lock->scan_lock);
+    
+    // Writers keep a built table current, so only a dropped one is rebuilt
+    ProductTable* table = &store->scan_table;
+    if (!table->is_built &&
+        !product_table_rebuild(table, &store->product_handles, store->categories, store->category_count)) {
+        table = NULL;
+    }
+    
+    if (store->lock) mutex_unlock(&store->lock->scan_lock);
+    return table;
+}
+
+static bool add_category_locked(DataStore* store, Category category) {
     if (!store) {
         fprintf(stderr, "Error: DataStore pointer is NULL\n");
         return false;
@@ -237,6 +675,11 @@ bool datastore_add_category(DataStore* store, Category category) {
         return false;
     }
     
+    if (!category_ids_free(store, &category) ||
+        !txn_reserve(store) || !reserve_category_handles(store, &category)) {
+        return false;
+    }
+    
     // Check if capacity needs to be expanded
     if (store->category_count >= store->category_capacity) {
         int new_capacity = store->category_capacity * 2;
@@ -254,12 +697,25 @@ bool datastore_add_category(DataStore* store, Category category) {
     // Add category
     store->categories[store->category_count] = category;
     store->category_count++;
-    store->is_modified = true;
+    store_changed(store, 0, 0);
+    
+    register_category_handles(store, store->category_count - 1);
+    txn_log(store, UNDO_ADD_CATEGORY, category.id, store->category_count - 1);
+    claim_id(store, ID_CATEGORY, category.id);
     
     return true;
 }
 
-bool datastore_remove_category(DataStore* store, int category_id) {
+bool datastore_add_category(DataStore* store, Category category) {
+    MetricTimer timer = METRICS_START();
+    datastore_write_lock(store);
+    bool ok = add_category_locked(store, category);
+    datastore_write_unlock(store);
+    METRICS_STOP(METRIC_DATASTORE_ADD_CATEGORY, timer, ok);
+    return ok;
+}
+
+static bool remove_category_locked(DataStore* store, int category_id) {
     if (!store) {
         fprintf(stderr, "Error: DataStore pointer is NULL\n");
         return false;
@@ -279,221 +735,1517 @@ bool datastore_remove_category(DataStore* store, int category_id) {
         return false;
     }
     
-    // Free category resources
-    category_free(&store->categories[index]);
+    if (!txn_reserve(store)) {
+        return false;
+    }
+    
+    // Free category resources, or keep them for the undo log
+    release_category_handles(store, &store->categories[index]);
+    UndoRecord* record = txn_log(store, UNDO_REMOVE_CATEGORY, category_id, index);
+    if (record) {
+        record->before.category = store->categories[index];
+    } else {
+        category_free(&store->categories[index]);
+    }
     
     // Use swap-and-pop (consistent with other remove operations)
     int last_index = store->category_count - 1;
     if (index < last_index) {
         store->categories[index] = store->categories[last_index];
+        handle_table_move(&store->category_handles, store->categories[index].id, index);
     }
     
     store->category_count--;
-    store->is_modified = true;
+    store_changed(store, category_id, 0);
     
     return true;
 }
 
-Category* datastore_find_category_by_id(DataStore* store, int category_id) {
-    if (!store) return NULL;
+bool datastore_remove_category(DataStore* store, int category_id) {
+    MetricTimer timer = METRICS_START();
+    datastore_write_lock(store);
+    bool ok = remove_category_locked(store, category_id);
+    datastore_write_unlock(store);
+    METRICS_STOP(METRIC_DATASTORE_REMOVE_CATEGORY, timer, ok);
+    return ok;
+}
+
+static bool add_subgroup_locked(DataStore* store, int category_id, Subgroup subgroup) {
+    if (!store) {
+        fprintf(stderr, "Error: DataStore pointer is NULL\n");
+        return false;
+    }
     
-    for (int i = 0; i < store->category_count; i++) {
-        if (store->categories[i].id == category_id) {
-            return &store->categories[i];
-        }
+    Category* category = datastore_find_category_by_id(store, category_id);
+    if (!category) {
+        fprintf(stderr, "Error: Category ID %d not found\n", category_id);
+        return false;
     }
     
-    return NULL;
+    if (!subgroup_ids_free(store, &subgroup) ||
+        !txn_reserve(store) || !reserve_subgroup_handles(store, &subgroup) ||
+        !category_add_subgroup(category, subgroup)) {
+        return false;
+    }
+    
+    int cat_slot = handle_table_slot_of(&store->category_handles, category_id);
+    int sub_index = category->subgroup_count - 1;
+    register_subgroup_handles(store, cat_slot, &category->subgroups[sub_index], sub_index);
+    txn_log(store, UNDO_ADD_SUBGROUP, category_id, sub_index);
+    claim_id(store, ID_SUBGROUP, subgroup.id);
+    
+    store_changed(store, category_id, 0);
+    return true;
 }
 
-Subgroup* datastore_find_subgroup_by_id(DataStore* store, int subgroup_id) {
-    if (!store) return NULL;
+bool datastore_add_subgroup(DataStore* store, int category_id, Subgroup subgroup) {
+    MetricTimer timer = METRICS_START();
+    datastore_write_lock(store);
+    bool ok = add_subgroup_locked(store, category_id, subgroup);
+    datastore_write_unlock(store);
+    METRICS_STOP(METRIC_DATASTORE_ADD_SUBGROUP, timer, ok);
+    return ok;
+}
 
-    for (int i = 0; i < store->category_count; i++) {
+static bool remove_subgroup_locked(DataStore* store, int subgroup_id) {
+    if (!store) {
+        fprintf(stderr, "Error: DataStore pointer is NULL\n");
+        return false;
+    }
+    
+    Subgroup* subgroup = datastore_find_subgroup_by_id(store, subgroup_id);
+    if (!subgroup) {
+        fprintf(stderr, "Error: Subgroup ID %d not found\n", subgroup_id);
+        return false;
+    }
+    
+    Category* category = datastore_find_category_by_id(store, subgroup->category_id);
+    if (!category) {
+        fprintf(stderr, "Error: Category ID %d not found\n", subgroup->category_id);
+        return false;
+    }
+    
+    int index = (int)(subgroup - category->subgroups);
+    int last_index = category->subgroup_count - 1;
+    int moved_id = category->subgroups[last_index].id;
+    
+    if (!txn_reserve(store)) {
+        return false;
+    }
+    
+    release_subgroup_handles(store, subgroup);
+    
+    Subgroup removed;
+    if (!category_detach_subgroup(category, subgroup_id, &removed)) {
+        return false;
+    }
+    
+    UndoRecord* record = txn_log(store, UNDO_REMOVE_SUBGROUP, category->id, index);
+    if (record) {
+        record->before.subgroup = removed;
+    } else {
+        subgroup_free(&removed);
+    }
+    
+    // category_detach_subgroup swapped the last subgroup into the hole
+    if (index < last_index) {
+        handle_table_move(&store->subgroup_handles, moved_id, index);
+    }
+    
+    store_changed(store, category->id, subgroup_id);
+    return true;
+}
+
+bool datastore_remove_subgroup(DataStore* store, int subgroup_id) {
+    MetricTimer timer = METRICS_START();
+    datastore_write_lock(store);
+    bool ok = remove_subgroup_locked(store, subgroup_id);
+    datastore_write_unlock(store);
+    METRICS_STOP(METRIC_DATASTORE_REMOVE_SUBGROUP, timer, ok);
+    return ok;
+}
+
+static bool add_product_locked(DataStore* store, int subgroup_id, Product product) {
+    if (!store) {
+        fprintf(stderr, "Error: DataStore pointer is NULL\n");
+        return false;
+    }
+    
+    Subgroup* subgroup = datastore_find_subgroup_by_id(store, subgroup_id);
+    if (!subgroup) {
+        fprintf(stderr, "Error: Subgroup ID %d not found\n", subgroup_id);
+        return false;
+    }
+    
+    if (handle_table_slot_of(&store->product_handles, product.id) != HANDLE_INVALID_INDEX) {
+        fprintf(stderr, "Error: Product ID %d already exists\n", product.id);
+        return false;
+    }
+    
+    if (!txn_reserve(store) || !handle_table_reserve(&store->product_handles, 1) ||
+        !subgroup_add_product(subgroup, product)) {
+        return false;
+    }
+    
+    int sub_slot = handle_table_slot_of(&store->subgroup_handles, subgroup_id);
+    acquire_product_handle(store, &subgroup->products[subgroup->product_count - 1], sub_slot, subgroup->product_count - 1);
+    txn_log(store, UNDO_ADD_PRODUCT, subgroup_id, subgroup->product_count - 1);
+    claim_id(store, ID_PRODUCT, product.id);
+    
+    store_changed(store, subgroup->category_id, subgroup_id);
+    return true;
+}
+
+bool datastore_add_product(DataStore* store, int subgroup_id, Product product) {
+    MetricTimer timer = METRICS_START();
+    datastore_write_lock(store);
+    bool ok = add_product_locked(store, subgroup_id, product);
+    datastore_write_unlock(store);
+    METRICS_STOP(METRIC_DATASTORE_ADD_PRODUCT, timer, ok);
+    return ok;
+}
+
+/**
+ * @brief Remove a product and fix up its handles without publishing the change
+ * @param removed Receives the product and its former index, may be NULL
+ * @return Subgroup that held the product, NULL on failure
+ */
+static Subgroup* detach_product(DataStore* store, int product_id, Product* removed, int* removed_index) {
+    Product* product = datastore_find_product_by_id(store, product_id);
+    if (!product) {
+        fprintf(stderr, "Error: Product ID %d not found\n", product_id);
+        return NULL;
+    }
+    
+    Subgroup* subgroup = datastore_find_subgroup_by_id(store, product->subgroup_id);
+    if (!subgroup) {
+        fprintf(stderr, "Error: Subgroup ID %d not found\n", product->subgroup_id);
+        return NULL;
+    }
+    
+    int index = (int)(product - subgroup->products);
+    int last_index = subgroup->product_count - 1;
+    int moved_id = subgroup->products[last_index].id;
+    
+    if (removed) {
+        *removed = *product;
+        *removed_index = index;
+    }
+    
+    if (!subgroup_remove_product(subgroup, product_id)) {
+        return NULL;
+    }
+    
+    release_product_handle(store, product_id);
+    if (index < last_index) {
+        handle_table_move(&store->product_handles, moved_id, index);
+    }
+    
+    return subgroup;
+}
+
+static bool remove_product_locked(DataStore* store, int product_id) {
+    if (!store) {
+        fprintf(stderr, "Error: DataStore pointer is NULL\n");
+        return false;
+    }
+    
+    if (!txn_reserve(store)) {
+        return false;
+    }
+    
+    Product removed;
+    int index;
+    Subgroup* subgroup = detach_product(store, product_id, &removed, &index);
+    if (!subgroup) {
+        return false;
+    }
+    
+    UndoRecord* record = txn_log(store, UNDO_REMOVE_PRODUCT, subgroup->id, index);
+    if (record) {
+        record->before.product = removed;
+    }
+    
+    store_changed(store, subgroup->category_id, subgroup->id);
+    return true;
+}
+
+bool datastore_remove_product(DataStore* store, int product_id) {
+    MetricTimer timer = METRICS_START();
+    datastore_write_lock(store);
+    bool ok = remove_product_locked(store, product_id);
+    datastore_write_unlock(store);
+    METRICS_STOP(METRIC_DATASTORE_REMOVE_PRODUCT, timer, ok);
+    return ok;
+}
+
+static bool update_product_locked(DataStore* store, Product product) {
+    if (!store) {
+        fprintf(stderr, "Error: DataStore pointer is NULL\n");
+        return false;
+    }
+    
+    Product* target = datastore_find_product_by_id(store, product.id);
+    if (!target) {
+        fprintf(stderr, "Error: Product ID %d not found\n", product.id);
+        return false;
+    }
+    
+    product.subgroup_id = target->subgroup_id;
+    memcpy(product.created_at, target->created_at, sizeof(product.created_at));
+    product_update_timestamp(&product);
+    if (!product_is_valid(&product)) {
+        fprintf(stderr, "Error: Invalid product data\n");
+        return false;
+    }
+    
+    if (!txn_reserve(store)) {
+        return false;
+    }
+    
+    UndoRecord* record = txn_log(store, UNDO_UPDATE_PRODUCT, product.subgroup_id, 0);
+    if (record) {
+        record->before.product = *target;
+    }
+    
+    // Written in place, so the scan row and the folded name are patched here
+    *target = product;
+    refresh_product_row(store, target);
+    
+    Subgroup* subgroup = datastore_find_subgroup_by_id(store, product.subgroup_id);
+    store_changed(store, subgroup ? subgroup->category_id : 0, product.subgroup_id);
+    return true;
+}
+
+bool datastore_update_product(DataStore* store, Product product) {
+    MetricTimer timer = METRICS_START();
+    datastore_write_lock(store);
+    bool ok = update_product_locked(store, product);
+    datastore_write_unlock(store);
+    METRICS_STOP(METRIC_DATASTORE_UPDATE_PRODUCT, timer, ok);
+    return ok;
+}
+
+static Category* find_category_by_id(DataStore* store, int category_id) {
+    if (!store) return NULL;
+    
+    Category* category = datastore_resolve_category(store, datastore_get_category_handle(store, category_id));
+    if (category) {
+        return category;
+    }
+    
+    for (int i = 0; i < store->category_count; i++) {
+        if (store->categories[i].id == category_id) {
+            return &store->categories[i];
+        }
+    }
+    
+    return NULL;
+}
+
+Category* datastore_find_category_by_id(DataStore* store, int category_id) {
+    MetricTimer timer = METRICS_START();
+    Category* found = find_category_by_id(store, category_id);
+    METRICS_STOP(METRIC_DATASTORE_FIND_CATEGORY, timer, found != NULL);
+    return found;
+}
+
+static Subgroup* find_subgroup_by_id(DataStore* store, int subgroup_id) {
+    if (!store) return NULL;
+
+    Subgroup* found = datastore_resolve_subgroup(store, datastore_get_subgroup_handle(store, subgroup_id));
+    if (found) {
+        return found;
+    }
+
+    for (int i = 0; i < store->category_count; i++) {
         Subgroup* subgroup = category_find_subgroup_by_id(&store->categories[i], subgroup_id);
         if (subgroup) {
             return subgroup;
         }
     }
 
-    return NULL;
+    return NULL;
+}
+
+Subgroup* datastore_find_subgroup_by_id(DataStore* store, int subgroup_id) {
+    MetricTimer timer = METRICS_START();
+    Subgroup* found = find_subgroup_by_id(store, subgroup_id);
+    METRICS_STOP(METRIC_DATASTORE_FIND_SUBGROUP, timer, found != NULL);
+    return found;
+}
+
+static Product* find_product_by_id(DataStore* store, int product_id) {
+    if (!store) return NULL;
+
+    // Every product is registered, so a miss is final; scanning the whole
+    // catalog here would make each lookup O(N)
+    return datastore_resolve_product(store, datastore_get_product_handle(store, product_id));
+}
+
+Product* datastore_find_product_by_id(DataStore* store, int product_id) {
+    MetricTimer timer = METRICS_START();
+    Product* found = find_product_by_id(store, product_id);
+    METRICS_STOP(METRIC_DATASTORE_FIND_PRODUCT, timer, found != NULL);
+    return found;
+}
+
+Product* datastore_find_product_by_code(DataStore* store, const char* code) {
+    if (!store || !code) return NULL;
+    
+    for (int i = 0; i < store->category_count; i++) {
+        Category* category = &store->categories[i];
+        for (int j = 0; j < category->subgroup_count; j++) {
+            Subgroup* subgroup = &category->subgroups[j];
+            for (int k = 0; k < subgroup->product_count; k++) {
+                if (strcmp(subgroup->products[k].code, code) == 0) {
+                    return &subgroup->products[k];
+                }
+            }
+        }
+    }
+    
+    return NULL;
+}
+
+// ============================================================================
+// ID Allocation
+// ============================================================================
+
+/**
+ * @brief Reserve count consecutive IDs
+ * @return First reserved ID, 0 on failure
+ */
+static int reserve_ids(DataStore* store, IdKind kind, int count) {
+    if (!store) {
+        fprintf(stderr, "Error: DataStore pointer is NULL\n");
+        return 0;
+    }
+    
+    atomic_int* counter = id_counter(store, kind);
+    if (!counter || count <= 0) {
+        fprintf(stderr, "Error: Invalid ID request\n");
+        return 0;
+    }
+    
+    // Atomic arithmetic wraps, so an exhausted counter only ever yields invalid ranges
+    int first = atomic_fetch_add(counter, count);
+    if (first <= 0 || first > INT_MAX - count) {
+        fprintf(stderr, "Error: ID space exhausted\n");
+        return 0;
+    }
+    
+    return first;
+}
+
+int datastore_allocate_id(DataStore* store, IdKind kind) {
+    return reserve_ids(store, kind, 1);
+}
+
+void id_block_init(IdBlock* block, IdKind kind, int batch) {
+    if (!block) return;
+    
+    block->kind = kind;
+    block->next = 0;
+    block->end = 0;
+    block->batch = batch > 0 ? batch : 1;
+}
+
+int datastore_allocate_id_from(DataStore* store, IdBlock* block) {
+    if (!block) {
+        fprintf(stderr, "Error: IdBlock pointer is NULL\n");
+        return 0;
+    }
+    
+    if (block->next >= block->end) {
+        int first = reserve_ids(store, block->kind, block->batch);
+        if (first == 0) return 0;
+        
+        block->next = first;
+        block->end = first + block->batch;
+    }
+    
+    return block->next++;
+}
+
+// ============================================================================
+// Handle Resolution
+// ============================================================================
+
+CategoryHandle datastore_get_category_handle(DataStore* store, int category_id) {
+    CategoryHandle handle = {HANDLE_INVALID_INDEX, 0};
+    if (!store) return handle;
+    
+    handle.index = handle_table_slot_of(&store->category_handles, category_id);
+    if (handle.index != HANDLE_INVALID_INDEX) {
+        handle.generation = store->category_handles.slots[handle.index].generation;
+    }
+    return handle;
+}
+
+SubgroupHandle datastore_get_subgroup_handle(DataStore* store, int subgroup_id) {
+    SubgroupHandle handle = {HANDLE_INVALID_INDEX, 0};
+    if (!store) return handle;
+    
+    handle.index = handle_table_slot_of(&store->subgroup_handles, subgroup_id);
+    if (handle.index != HANDLE_INVALID_INDEX) {
+        handle.generation = store->subgroup_handles.slots[handle.index].generation;
+    }
+    return handle;
+}
+
+ProductHandle datastore_get_product_handle(DataStore* store, int product_id) {
+    ProductHandle handle = {HANDLE_INVALID_INDEX, 0};
+    if (!store) return handle;
+    
+    handle.index = handle_table_slot_of(&store->product_handles, product_id);
+    if (handle.index != HANDLE_INVALID_INDEX) {
+        handle.generation = store->product_handles.slots[handle.index].generation;
+    }
+    return handle;
+}
+
+/**
+ * @brief Map a live category slot to its array entry
+ */
+static Category* category_at_slot(DataStore* store, int slot_index) {
+    if (slot_index < 0 || slot_index >= store->category_handles.slot_count) return NULL;
+    
+    const HandleSlot* slot = &store->category_handles.slots[slot_index];
+    if (slot->id == 0 || slot->array_index < 0 || slot->array_index >= store->category_count) {
+        return NULL;
+    }
+    
+    Category* category = &store->categories[slot->array_index];
+    return category->id == slot->id ? category : NULL;
+}
+
+/**
+ * @brief Map a live subgroup slot to its array entry
+ */
+static Subgroup* subgroup_at_slot(DataStore* store, int slot_index) {
+    if (slot_index < 0 || slot_index >= store->subgroup_handles.slot_count) return NULL;
+    
+    const HandleSlot* slot = &store->subgroup_handles.slots[slot_index];
+    Category* category = category_at_slot(store, slot->parent_slot);
+    if (!category || slot->id == 0 ||
+        slot->array_index < 0 || slot->array_index >= category->subgroup_count) {
+        return NULL;
+    }
+    
+    Subgroup* subgroup = &category->subgroups[slot->array_index];
+    return subgroup->id == slot->id ? subgroup : NULL;
+}
+
+/**
+ * @brief Map a live product slot to its array entry
+ */
+static Product* product_at_slot(DataStore* store, int slot_index) {
+    if (slot_index < 0 || slot_index >= store->product_handles.slot_count) return NULL;
+    
+    const HandleSlot* slot = &store->product_handles.slots[slot_index];
+    Subgroup* subgroup = subgroup_at_slot(store, slot->parent_slot);
+    if (!subgroup || slot->id == 0 ||
+        slot->array_index < 0 || slot->array_index >= subgroup->product_count) {
+        return NULL;
+    }
+    
+    Product* product = &subgroup->products[slot->array_index];
+    return product->id == slot->id ? product : NULL;
+}
+
+Category* datastore_resolve_category(DataStore* store, CategoryHandle handle) {
+    if (!store) return NULL;
+    
+    if (!handle_table_lookup(&store->category_handles, handle.index, handle.generation)) {
+        return NULL;
+    }
+    return category_at_slot(store, handle.index);
+}
+
+Subgroup* datastore_resolve_subgroup(DataStore* store, SubgroupHandle handle) {
+    if (!store) return NULL;
+    
+    if (!handle_table_lookup(&store->subgroup_handles, handle.index, handle.generation)) {
+        return NULL;
+    }
+    return subgroup_at_slot(store, handle.index);
+}
+
+Product* datastore_resolve_product(DataStore* store, ProductHandle handle) {
+    if (!store) return NULL;
+    
+    if (!handle_table_lookup(&store->product_handles, handle.index, handle.generation)) {
+        return NULL;
+    }
+    return product_at_slot(store, handle.index);
+}
+
+// ============================================================================
+// Batched Mutations
+// ============================================================================
+
+void datastore_batch_begin(DataStoreBatch* batch, DataStore* store) {
+    if (!batch) return;
+    
+    batch->store = store;
+    batch->ops = NULL;
+    batch->op_count = 0;
+    batch->op_capacity = 0;
+}
+
+void datastore_batch_discard(DataStoreBatch* batch) {
+    if (!batch) return;
+    
+    free(batch->ops);
+    batch->ops = NULL;
+    batch->op_count = 0;
+    batch->op_capacity = 0;
+}
+
+static bool batch_push(DataStoreBatch* batch, BatchOpKind kind, int subgroup_id, const Product* product) {
+    if (!batch || !batch->store) {
+        fprintf(stderr, "Error: Batch was not started\n");
+        return false;
+    }
+    
+    if (batch->op_count >= batch->op_capacity) {
+        int new_capacity = batch->op_capacity > 0 ? batch->op_capacity * 2 : INITIAL_BATCH_CAPACITY;
+        BatchOp* new_ops = (BatchOp*)realloc(batch->ops, new_capacity * sizeof(BatchOp));
+        if (!new_ops) {
+            fprintf(stderr, "Error: Failed to expand batch\n");
+            return false;
+        }
+        batch->ops = new_ops;
+        batch->op_capacity = new_capacity;
+    }
+    
+    BatchOp* op = &batch->ops[batch->op_count++];
+    op->kind = kind;
+    op->subgroup_id = subgroup_id;
+    op->product = *product;
+    return true;
+}
+
+bool datastore_batch_add(DataStoreBatch* batch, int subgroup_id, Product product) {
+    MetricTimer timer = METRICS_START();
+    product.subgroup_id = subgroup_id;
+    bool ok = batch_push(batch, BATCH_ADD, subgroup_id, &product);
+    METRICS_STOP(METRIC_DATASTORE_BATCH_ADD, timer, ok);
+    return ok;
+}
+
+bool datastore_batch_update(DataStoreBatch* batch, Product product) {
+    MetricTimer timer = METRICS_START();
+    bool ok = batch_push(batch, BATCH_UPDATE, 0, &product);
+    METRICS_STOP(METRIC_DATASTORE_BATCH_UPDATE, timer, ok);
+    return ok;
+}
+
+bool datastore_batch_remove(DataStoreBatch* batch, int product_id) {
+    MetricTimer timer = METRICS_START();
+    Product product;
+    memset(&product, 0, sizeof(product));
+    product.id = product_id;
+    bool ok = batch_push(batch, BATCH_REMOVE, 0, &product);
+    METRICS_STOP(METRIC_DATASTORE_BATCH_REMOVE, timer, ok);
+    return ok;
+}
+
+static int compare_ints(const void* a, const void* b) {
+    int x = *(const int*)a;
+    int y = *(const int*)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Check every operation against the current store before anything changes
+ */
+static bool batch_validate(DataStore* store, const DataStoreBatch* batch) {
+    for (int i = 0; i < batch->op_count; i++) {
+        const BatchOp* op = &batch->ops[i];
+        int id = op->product.id;
+        
+        if (op->kind == BATCH_ADD) {
+            if (!product_is_valid(&op->product)) {
+                fprintf(stderr, "Error: Batch operation %d has invalid product data\n", i);
+                return false;
+            }
+            if (!subgroup_at_slot(store, handle_table_slot_of(&store->subgroup_handles, op->subgroup_id))) {
+                fprintf(stderr, "Error: Subgroup ID %d not found\n", op->subgroup_id);
+                return false;
+            }
+            if (handle_table_slot_of(&store->product_handles, id) != HANDLE_INVALID_INDEX) {
+                fprintf(stderr, "Error: Product ID %d already exists\n", id);
+                return false;
+            }
+        } else {
+            const Product* existing = datastore_find_product_by_id(store, id);
+            if (!existing) {
+                fprintf(stderr, "Error: Product ID %d not found\n", id);
+                return false;
+            }
+            
+            Product updated = op->product;
+            updated.subgroup_id = existing->subgroup_id;
+            if (op->kind == BATCH_UPDATE && !product_is_valid(&updated)) {
+                fprintf(stderr, "Error: Batch operation %d has invalid product data\n", i);
+                return false;
+            }
+        }
+    }
+    
+    // Touching one product twice would make the outcome depend on operation order
+    int* ids = (int*)malloc(batch->op_count * sizeof(int));
+    if (!ids) {
+        fprintf(stderr, "Error: Failed to allocate batch validation buffer\n");
+        return false;
+    }
+    
+    for (int i = 0; i < batch->op_count; i++) {
+        ids[i] = batch->ops[i].product.id;
+    }
+    qsort(ids, batch->op_count, sizeof(int), compare_ints);
+    
+    bool unique = true;
+    for (int i = 1; i < batch->op_count && unique; i++) {
+        if (ids[i] == ids[i - 1]) {
+            fprintf(stderr, "Error: Product ID %d appears more than once in batch\n", ids[i]);
+            unique = false;
+        }
+    }
+    
+    free(ids);
+    return unique;
+}
+
+/**
+ * @brief Grow each target subgroup once for all of its queued adds, and the
+ *        product handle table for all of them together
+ */
+static bool batch_reserve(DataStore* store, const DataStoreBatch* batch) {
+    int slot_count = store->subgroup_handles.slot_count;
+    int* pending = (int*)calloc(slot_count > 0 ? slot_count : 1, sizeof(int));
+    if (!pending) {
+        fprintf(stderr, "Error: Failed to allocate batch reservation buffer\n");
+        return false;
+    }
+    
+    int adds = 0;
+    for (int i = 0; i < batch->op_count; i++) {
+        if (batch->ops[i].kind == BATCH_ADD) {
+            pending[handle_table_slot_of(&store->subgroup_handles, batch->ops[i].subgroup_id)]++;
+            adds++;
+        }
+    }
+    
+    bool ok = handle_table_reserve(&store->product_handles, adds);
+    for (int slot = 0; slot < slot_count && ok; slot++) {
+        if (pending[slot] > 0) {
+            Subgroup* subgroup = subgroup_at_slot(store, slot);
+            ok = subgroup_reserve(subgroup, subgroup->product_count + pending[slot]);
+        }
+    }
+    
+    free(pending);
+    return ok;
+}
+
+static bool batch_commit_locked(DataStore* store, const DataStoreBatch* batch) {
+    if (store->txn) {
+        fprintf(stderr, "Error: Batches cannot be committed inside a transaction\n");
+        return false;
+    }
+    
+    if (!batch_validate(store, batch) || !batch_reserve(store, batch)) {
+        return false;
+    }
+    
+    // Nothing below can fail: every target exists, every added ID is new and
+    // positive, and the subgroup arrays and the handle table have room. (A
+    // scan table row that cannot grow only drops the table for a rebuild.)
+    for (int i = 0; i < batch->op_count; i++) {
+        const BatchOp* op = &batch->ops[i];
+        Subgroup* subgroup = NULL;
+        
+        switch (op->kind) {
+            case BATCH_UPDATE: {
+                Product* target = datastore_find_product_by_id(store, op->product.id);
+                Product updated = op->product;
+                updated.subgroup_id = target->subgroup_id;
+                memcpy(updated.created_at, target->created_at, sizeof(updated.created_at));
+                product_update_timestamp(&updated);
+                *target = updated;
+                refresh_product_row(store, target);
+                subgroup = datastore_find_subgroup_by_id(store, target->subgroup_id);
+                break;
+            }
+            case BATCH_REMOVE:
+                subgroup = detach_product(store, op->product.id, NULL, NULL);
+                break;
+            case BATCH_ADD: {
+                int slot = handle_table_slot_of(&store->subgroup_handles, op->subgroup_id);
+                subgroup = subgroup_at_slot(store, slot);
+                
+                Product* product = &subgroup->products[subgroup->product_count];
+                *product = op->product;
+                acquire_product_handle(store, product, slot, subgroup->product_count);
+                subgroup->product_count++;
+                claim_id(store, ID_PRODUCT, product->id);
+                break;
+            }
+        }
+        
+        if (store->snapshots && subgroup) {
+            snapshot_invalidate(store->snapshots, subgroup->category_id, subgroup->id);
+        }
+    }
+    
+    if (batch->op_count > 0) {
+        store_changed(store, 0, 0);
+    }
+    return true;
+}
+
+static bool batch_commit(DataStoreBatch* batch) {
+    if (!batch || !batch->store) {
+        fprintf(stderr, "Error: Batch was not started\n");
+        return false;
+    }
+    
+    DataStore* store = batch->store;
+    datastore_write_lock(store);
+    bool ok = batch_commit_locked(store, batch);
+    datastore_write_unlock(store);
+    
+    datastore_batch_discard(batch);
+    return ok;
+}
+
+bool datastore_batch_commit(DataStoreBatch* batch) {
+    MetricTimer timer = METRICS_START();
+    bool ok = batch_commit(batch);
+    METRICS_STOP(METRIC_DATASTORE_BATCH_COMMIT, timer, ok);
+    return ok;
+}
+
+// ============================================================================
+// Transactions
+// ============================================================================
+
+bool datastore_txn_begin(DataStoreTxn* txn, DataStore* store) {
+    if (!txn || !store) {
+        fprintf(stderr, "Error: DataStore pointer is NULL\n");
+        return false;
+    }
+    
+    datastore_write_lock(store);
+    if (store->txn) {
+        datastore_write_unlock(store);
+        fprintf(stderr, "Error: A transaction is already open\n");
+        return false;
+    }
+    
+    txn->store = store;
+    txn->records = NULL;
+    txn->record_count = 0;
+    txn->record_capacity = 0;
+    txn->was_modified = store->is_modified;
+    store->txn = txn;
+    return true;
+}
+
+/**
+ * @brief Store of an open transaction, NULL (with a message) otherwise
+ */
+static DataStore* txn_store(DataStoreTxn* txn) {
+    if (!txn || !txn->store || txn->store->txn != txn) {
+        fprintf(stderr, "Error: Transaction is not open\n");
+        return NULL;
+    }
+    return txn->store;
 }
 
-Product* datastore_find_product_by_id(DataStore* store, int product_id) {
-    if (!store) return NULL;
+bool datastore_txn_add_category(DataStoreTxn* txn, Category category) {
+    MetricTimer timer = METRICS_START();
+    DataStore* store = txn_store(txn);
+    bool ok = store && add_category_locked(store, category);
+    METRICS_STOP(METRIC_DATASTORE_TXN_ADD_CATEGORY, timer, ok);
+    return ok;
+}
 
-    for (int i = 0; i < store->category_count; i++) {
-        for (int j = 0; j < store->categories[i].subgroup_count; j++) {
-            Product* product = subgroup_find_product_by_id(&store->categories[i].subgroups[j], product_id);
-            if (product) {
-                return product;
+bool datastore_txn_remove_category(DataStoreTxn* txn, int category_id) {
+    MetricTimer timer = METRICS_START();
+    DataStore* store = txn_store(txn);
+    bool ok = store && remove_category_locked(store, category_id);
+    METRICS_STOP(METRIC_DATASTORE_TXN_REMOVE_CATEGORY, timer, ok);
+    return ok;
+}
+
+bool datastore_txn_add_subgroup(DataStoreTxn* txn, int category_id, Subgroup subgroup) {
+    MetricTimer timer = METRICS_START();
+    DataStore* store = txn_store(txn);
+    bool ok = store && add_subgroup_locked(store, category_id, subgroup);
+    METRICS_STOP(METRIC_DATASTORE_TXN_ADD_SUBGROUP, timer, ok);
+    return ok;
+}
+
+bool datastore_txn_remove_subgroup(DataStoreTxn* txn, int subgroup_id) {
+    MetricTimer timer = METRICS_START();
+    DataStore* store = txn_store(txn);
+    bool ok = store && remove_subgroup_locked(store, subgroup_id);
+    METRICS_STOP(METRIC_DATASTORE_TXN_REMOVE_SUBGROUP, timer, ok);
+    return ok;
+}
+
+bool datastore_txn_add_product(DataStoreTxn* txn, int subgroup_id, Product product) {
+    MetricTimer timer = METRICS_START();
+    DataStore* store = txn_store(txn);
+    bool ok = store && add_product_locked(store, subgroup_id, product);
+    METRICS_STOP(METRIC_DATASTORE_TXN_ADD_PRODUCT, timer, ok);
+    return ok;
+}
+
+bool datastore_txn_remove_product(DataStoreTxn* txn, int product_id) {
+    MetricTimer timer = METRICS_START();
+    DataStore* store = txn_store(txn);
+    bool ok = store && remove_product_locked(store, product_id);
+    METRICS_STOP(METRIC_DATASTORE_TXN_REMOVE_PRODUCT, timer, ok);
+    return ok;
+}
+
+static bool txn_update_product(DataStoreTxn* txn, Product product) {
+    DataStore* store = txn_store(txn);
+    return store && update_product_locked(store, product);
+}
+
+static bool txn_move_product(DataStoreTxn* txn, int product_id, int subgroup_id) {
+    DataStore* store = txn_store(txn);
+    if (!store) return false;
+    
+    Product* product = datastore_find_product_by_id(store, product_id);
+    if (!product) {
+        fprintf(stderr, "Error: Product ID %d not found\n", product_id);
+        return false;
+    }
+    
+    if (!datastore_find_subgroup_by_id(store, subgroup_id)) {
+        fprintf(stderr, "Error: Subgroup ID %d not found\n", subgroup_id);
+        return false;
+    }
+    
+    Product moved = *product;
+    moved.subgroup_id = subgroup_id;
+    
+    // Each half is logged, so a failed add is undone by the caller's abort
+    return remove_product_locked(store, product_id) &&
+           add_product_locked(store, subgroup_id, moved);
+}
+
+bool datastore_txn_update_product(DataStoreTxn* txn, Product product) {
+    MetricTimer timer = METRICS_START();
+    bool ok = txn_update_product(txn, product);
+    METRICS_STOP(METRIC_DATASTORE_TXN_UPDATE_PRODUCT, timer, ok);
+    return ok;
+}
+
+bool datastore_txn_move_product(DataStoreTxn* txn, int product_id, int subgroup_id) {
+    MetricTimer timer = METRICS_START();
+    bool ok = txn_move_product(txn, product_id, subgroup_id);
+    METRICS_STOP(METRIC_DATASTORE_TXN_MOVE_PRODUCT, timer, ok);
+    return ok;
+}
+
+/**
+ * @brief Reverse one logged change; runs in reverse log order
+ * @return false if a restored entity could not be registered in the handle tables
+ *
+ * Every record is undone against exactly the state its change produced,
+ * so appended entities are the last element and a removed entity's slot
+ * holds what swap-and-pop moved there.
+ */
+static bool undo_record(DataStore* store, UndoRecord* record) {
+    bool ok = true;
+    
+    switch (record->kind) {
+        case UNDO_ADD_CATEGORY: {
+            Category* category = &store->categories[store->category_count - 1];
+            release_category_handles(store, category);
+            category_free(category);
+            store->category_count--;
+            store_changed(store, record->owner_id, 0);
+            break;
+        }
+        case UNDO_REMOVE_CATEGORY: {
+            int end = store->category_count;
+            if (record->index < end) {
+                store->categories[end] = store->categories[record->index];
+                handle_table_move(&store->category_handles, store->categories[end].id, end);
+            }
+            store->categories[record->index] = record->before.category;
+            store->category_count++;
+            ok = register_category_handles(store, record->index);
+            store_changed(store, record->owner_id, 0);
+            break;
+        }
+        case UNDO_ADD_SUBGROUP: {
+            Category* category = datastore_find_category_by_id(store, record->owner_id);
+            Subgroup* subgroup = &category->subgroups[category->subgroup_count - 1];
+            int subgroup_id = subgroup->id;
+            release_subgroup_handles(store, subgroup);
+            subgroup_free(subgroup);
+            category->subgroup_count--;
+            store_changed(store, record->owner_id, subgroup_id);
+            break;
+        }
+        case UNDO_REMOVE_SUBGROUP: {
+            Category* category = datastore_find_category_by_id(store, record->owner_id);
+            int cat_slot = handle_table_slot_of(&store->category_handles, record->owner_id);
+            int end = category->subgroup_count;
+            if (record->index < end) {
+                category->subgroups[end] = category->subgroups[record->index];
+                handle_table_move(&store->subgroup_handles, category->subgroups[end].id, end);
+            }
+            category->subgroups[record->index] = record->before.subgroup;
+            category->subgroup_count++;
+            ok = register_subgroup_handles(store, cat_slot, &category->subgroups[record->index], record->index);
+            store_changed(store, record->owner_id, record->before.subgroup.id);
+            break;
+        }
+        case UNDO_ADD_PRODUCT: {
+            Subgroup* subgroup = datastore_find_subgroup_by_id(store, record->owner_id);
+            subgroup->product_count--;
+            release_product_handle(store, subgroup->products[subgroup->product_count].id);
+            store_changed(store, subgroup->category_id, subgroup->id);
+            break;
+        }
+        case UNDO_REMOVE_PRODUCT: {
+            Subgroup* subgroup = datastore_find_subgroup_by_id(store, record->owner_id);
+            int sub_slot = handle_table_slot_of(&store->subgroup_handles, record->owner_id);
+            int end = subgroup->product_count;
+            if (record->index < end) {
+                subgroup->products[end] = subgroup->products[record->index];
+                handle_table_move(&store->product_handles, subgroup->products[end].id, end);
             }
+            subgroup->products[record->index] = record->before.product;
+            subgroup->product_count++;
+            ok = acquire_product_handle(store, &subgroup->products[record->index], sub_slot, record->index) !=
+                 HANDLE_INVALID_INDEX;
+            store_changed(store, subgroup->category_id, subgroup->id);
+            break;
         }
+        case UNDO_UPDATE_PRODUCT: {
+            Product* product = datastore_find_product_by_id(store, record->before.product.id);
+            *product = record->before.product;
+            refresh_product_row(store, product);
+            Subgroup* subgroup = datastore_find_subgroup_by_id(store, record->owner_id);
+            store_changed(store, subgroup->category_id, subgroup->id);
+            break;
+        }
+    }
+    
+    return ok;
+}
+
+/**
+ * @brief Close the transaction, publish its outcome and release the lock
+ */
+static void txn_finish(DataStore* store, DataStoreTxn* txn) {
+    bool changed = txn->record_count > 0;
+    
+    store->txn = NULL;
+    free(txn->records);
+    txn->records = NULL;
+    txn->record_count = 0;
+    txn->record_capacity = 0;
+    txn->store = NULL;
+    
+    if (changed) {
+        publish_snapshot(store);
     }
+    datastore_write_unlock(store);
+}
 
-    return NULL;
+static bool txn_commit(DataStoreTxn* txn) {
+    DataStore* store = txn_store(txn);
+    if (!store) return false;
+    
+    // Removed entities were kept alive for a possible abort
+    for (int i = 0; i < txn->record_count; i++) {
+        UndoRecord* record = &txn->records[i];
+        if (record->kind == UNDO_REMOVE_CATEGORY) {
+            category_free(&record->before.category);
+        } else if (record->kind == UNDO_REMOVE_SUBGROUP) {
+            subgroup_free(&record->before.subgroup);
+        }
+    }
+    
+    txn_finish(store, txn);
+    return true;
+}
+
+bool datastore_txn_commit(DataStoreTxn* txn) {
+    MetricTimer timer = METRICS_START();
+    bool ok = txn_commit(txn);
+    METRICS_STOP(METRIC_DATASTORE_TXN_COMMIT, timer, ok);
+    return ok;
+}
+
+static bool txn_abort(DataStoreTxn* txn) {
+    DataStore* store = txn_store(txn);
+    if (!store) return false;
+    
+    // Restored entities get back the room their removal freed in the handle
+    // tables, so registering them should not fail; if it does, the handles
+    // are derived again from the restored hierarchy
+    bool handles_ok = true;
+    for (int i = txn->record_count - 1; i >= 0; i--) {
+        handles_ok = undo_record(store, &txn->records[i]) && handles_ok;
+    }
+    if (!handles_ok) {
+        fprintf(stderr, "Error: Failed to restore handles, rebuilding them\n");
+        datastore_rebuild_handles(store);
+    }
+    
+    // Content is back to where it was; the version keeps moving forward
+    store->is_modified = txn->was_modified;
+    txn_finish(store, txn);
+    return true;
+}
+
+void datastore_txn_abort(DataStoreTxn* txn) {
+    MetricTimer timer = METRICS_START();
+    bool ok = txn_abort(txn);
+    METRICS_STOP(METRIC_DATASTORE_TXN_ABORT, timer, ok);
 }
 
 // ============================================================================
-// Search Functions (OPTIMIZED - Single Pass)
+// Compaction
 // ============================================================================
 
-SearchResult datastore_search_products_by_name(DataStore* store, const char* name) {
-    SearchResult result = {NULL, 0};
+static void compact_note(CompactResult* result, size_t released) {
+    if (!result || released == 0) return;
+    result->bytes_released += released;
+    result->arrays_shrunk++;
+}
+
+static void shrink_categories(DataStore* store, CompactResult* result) {
+    int new_capacity = store->category_count > INITIAL_CATEGORY_CAPACITY ?
+                       store->category_count : INITIAL_CATEGORY_CAPACITY;
+    if (!store->categories || new_capacity >= store->category_capacity) return;
     
-    if (!store || !name) return result;
+    Category* new_categories = (Category*)realloc(store->categories, new_capacity * sizeof(Category));
+    if (!new_categories) return;
     
-    char search_lower[100];
-    strncpy(search_lower, name, sizeof(search_lower) - 1);
-    search_lower[sizeof(search_lower) - 1] = '\0';
-    for (int i = 0; search_lower[i]; i++) {
-        search_lower[i] = tolower(search_lower[i]);
-    }
+    compact_note(result, (size_t)(store->category_capacity - new_capacity) * sizeof(Category));
+    store->categories = new_categories;
+    store->category_capacity = new_capacity;
+}
+
+/**
+ * @brief Free the scan table; the next scan rebuilds it at the current size
+ */
+static void release_scan_table(DataStore* store, CompactResult* result) {
+    const ProductTable* table = &store->scan_table;
+    size_t row = sizeof(int) + sizeof(float) + sizeof(int) + PRODUCT_NAME_SIZE;
+    size_t reserved = table->product_capacity * row + table->slot_capacity * sizeof(int);
+    
+    product_table_free(&store->scan_table);
+    compact_note(result, reserved);
+}
+
+/**
+ * @brief Give every entity the ID of its position, keeping array order
+ */
+static int renumber_ids(DataStore* store) {
+    int changed = 0;
+    int next_subgroup = 1;
+    int next_product = 1;
     
-    // Calculate max possible products
-    int max_products = 0;
     for (int i = 0; i < store->category_count; i++) {
-        for (int j = 0; j < store->categories[i].subgroup_count; j++) {
-            max_products += store->categories[i].subgroups[j].product_count;
+        Category* cat = &store->categories[i];
+        changed += cat->id != i + 1;
+        cat->id = i + 1;
+        
+        for (int j = 0; j < cat->subgroup_count; j++) {
+            Subgroup* sub = &cat->subgroups[j];
+            changed += sub->id != next_subgroup;
+            sub->id = next_subgroup++;
+            sub->category_id = cat->id;
+            
+            for (int k = 0; k < sub->product_count; k++) {
+                Product* prod = &sub->products[k];
+                changed += prod->id != next_product;
+                prod->id = next_product++;
+                prod->subgroup_id = sub->id;
+            }
         }
     }
     
-    if (max_products == 0) return result;
+    atomic_store(&store->next_category_id, store->category_count + 1);
+    atomic_store(&store->next_subgroup_id, next_subgroup);
+    atomic_store(&store->next_product_id, next_product);
+    return changed;
+}
+
+/**
+ * @brief Register every entity under its new ID and release spare handle storage
+ *
+ * The tables are cleared, not freed, so each slot's generation moves on and
+ * handles taken before the renumbering no longer resolve.
+ */
+static void rebuild_handle_tables(DataStore* store, CompactResult* result) {
+    datastore_rebuild_handles(store);
+    compact_note(result, handle_table_shrink_to_fit(&store->category_handles));
+    compact_note(result, handle_table_shrink_to_fit(&store->subgroup_handles));
+    compact_note(result, handle_table_shrink_to_fit(&store->product_handles));
+}
+
+static void trim_heap(void) {
+#if defined(__GLIBC__)
+    malloc_trim(0);
+#endif
+}
+
+static bool compact_locked(DataStore* store, bool renumber, CompactResult* result) {
+    if (store->txn) {
+        fprintf(stderr, "Error: Cannot compact inside a transaction\n");
+        return false;
+    }
     
-    result.products = (Product*)malloc(max_products * sizeof(Product));
-    if (!result.products) {
-        fprintf(stderr, "Error: Failed to allocate memory for search results\n");
-        return result;
+    if (renumber && store->ids_striped) {
+        fprintf(stderr, "Error: Cannot renumber the IDs of a shard\n");
+        return false;
     }
     
-    // Single pass: find and copy
-    int count = 0;
     for (int i = 0; i < store->category_count; i++) {
-        for (int j = 0; j < store->categories[i].subgroup_count; j++) {
-            for (int k = 0; k < store->categories[i].subgroups[j].product_count; k++) {
-                Product* p = &store->categories[i].subgroups[j].products[k];
-                
-                char product_name_lower[100];
-                strncpy(product_name_lower, p->name, sizeof(product_name_lower) - 1);
-                product_name_lower[sizeof(product_name_lower) - 1] = '\0';
-                for (int l = 0; product_name_lower[l]; l++) {
-                    product_name_lower[l] = tolower(product_name_lower[l]);
-                }
-                
-                if (strstr(product_name_lower, search_lower) != NULL) {
-                    result.products[count++] = *p;
-                }
-            }
+        Category* cat = &store->categories[i];
+        for (int j = 0; j < cat->subgroup_count; j++) {
+            compact_note(result, subgroup_shrink_to_fit(&cat->subgroups[j]));
         }
+        compact_note(result, category_shrink_to_fit(cat));
     }
+    shrink_categories(store, result);
+    release_scan_table(store, result);
     
-    // Resize to actual size
-    if (count < max_products && count > 0) {
-        Product* resized = (Product*)realloc(result.products, count * sizeof(Product));
-        if (resized) {
-            result.products = resized;
+    if (renumber) {
+        int changed = renumber_ids(store);
+        if (result) result->ids_renumbered += changed;
+        rebuild_handle_tables(store, result);
+        
+        if (changed > 0) {
+            store->is_modified = true;
+            store->version++;
+            if (store->snapshots) {
+                // Blocks are reused by ID, which now names different entities
+                snapshot_invalidate_all(store->snapshots);
+                publish_snapshot(store);
+            }
         }
-    } else if (count == 0) {
-        free(result.products);
-        result.products = NULL;
     }
     
-    result.count = count;
-    return result;
+    trim_heap();
+    return true;
 }
 
-SearchResult datastore_search_products_by_price(DataStore* store, float min_price, float max_price) {
-    SearchResult result = {NULL, 0};
+bool datastore_compact(DataStore* store, bool renumber_ids, CompactResult* result) {
+    if (!store) {
+        fprintf(stderr, "Error: DataStore pointer is NULL\n");
+        return false;
+    }
     
-    if (!store) return result;
+    if (result) memset(result, 0, sizeof(*result));
     
-    int max_products = 0;
-    for (int i = 0; i < store->category_count; i++) {
-        for (int j = 0; j < store->categories[i].subgroup_count; j++) {
-            max_products += store->categories[i].subgroups[j].product_count;
-        }
+    MetricTimer timer = METRICS_START();
+    datastore_write_lock(store);
+    bool ok = compact_locked(store, renumber_ids, result);
+    datastore_write_unlock(store);
+    METRICS_STOP(METRIC_DATASTORE_COMPACT, timer, ok);
+    return ok;
+}
+
+// ============================================================================
+// Search Functions (OPTIMIZED - Single Pass)
+// ============================================================================
+
+typedef enum {
+    QUERY_NAME,
+    QUERY_PRICE,
+    QUERY_QUANTITY
+} SearchKind;
+
+typedef struct {
+    SearchKind kind;
+    char needle[100];          // Lowercase, for QUERY_NAME
+    size_t needle_len;
+    float min_price;
+    float max_price;
+    int min_qty;
+    int max_qty;
+} SearchQuery;
+
+/**
+ * @brief Run the query's filter kernel over rows [begin, begin + count)
+ * @return Number of matches; bit i of bitmap refers to row begin + i
+ */
+static int search_filter_rows(const ProductTable* table, const SearchQuery* query,
+                              int begin, int count, uint64_t* bitmap) {
+    switch (query->kind) {
+        case QUERY_NAME:
+            // Names are folded when the table row is written, so the scan only reads the dense name column
+            return filter_text_contains(table->names_folded + (size_t)begin * PRODUCT_NAME_SIZE,
+                                        PRODUCT_NAME_SIZE, PRODUCT_NAME_SIZE, count,
+                                        query->needle, query->needle_len, bitmap);
+        case QUERY_PRICE:
+            return filter_price_range(table->prices + begin, count,
+                                      query->min_price, query->max_price, bitmap);
+        case QUERY_QUANTITY:
+            return filter_quantity_range(table->quantities + begin, count,
+                                         query->min_qty, query->max_qty, bitmap);
     }
+    return 0;
+}
+
+/**
+ * @brief Copy matching rows into a result, in category/subgroup/array order
+ * @param rows Match bitmap over every row of the table
+ * @param matches Number of bits set in rows
+ *
+ * Table rows are unordered, so each match is first placed at its position
+ * in the hierarchy (the products of all earlier subgroups plus its index in
+ * its own), and the positions are then read back in one ordered walk. No
+ * sort is needed and the cost is O(matches + products / 64 + subgroups).
+ */
+static SearchResult collect_matches(DataStore* store, const ProductTable* table,
+                                    const uint64_t* rows, int matches) {
+    SearchResult result = {NULL, 0};
+    if (matches <= 0) return result;
     
-    if (max_products == 0) return result;
-    
-    result.products = (Product*)malloc(max_products * sizeof(Product));
-    if (!result.products) {
+    int total = table->product_count;
+    int* first_position = (int*)malloc((store->subgroup_handles.slot_count + 1) * sizeof(int));
+    uint64_t* positions = (uint64_t*)calloc(FILTER_BITMAP_WORDS(total), sizeof(uint64_t));
+    result.products = (Product*)malloc(matches * sizeof(Product));
+    if (!first_position || !positions || !result.products) {
         fprintf(stderr, "Error: Failed to allocate memory for search results\n");
+        free(first_position);
+        free(positions);
+        free(result.products);
+        result.products = NULL;
         return result;
     }
     
-    int count = 0;
+    // Hierarchy position of each subgroup's first product, by subgroup slot
+    int position = 0;
     for (int i = 0; i < store->category_count; i++) {
-        for (int j = 0; j < store->categories[i].subgroup_count; j++) {
-            for (int k = 0; k < store->categories[i].subgroups[j].product_count; k++) {
-                Product* p = &store->categories[i].subgroups[j].products[k];
-                if (p->price >= min_price && p->price <= max_price) {
-                    result.products[count++] = *p;
-                }
+        const Category* cat = &store->categories[i];
+        for (int j = 0; j < cat->subgroup_count; j++) {
+            int slot = handle_table_slot_of(&store->subgroup_handles, cat->subgroups[j].id);
+            if (slot != HANDLE_INVALID_INDEX) {
+                first_position[slot] = position;
             }
+            position += cat->subgroups[j].product_count;
         }
     }
     
-    if (count < max_products && count > 0) {
-        Product* resized = (Product*)realloc(result.products, count * sizeof(Product));
-        if (resized) {
-            result.products = resized;
+    for (int w = 0; w < FILTER_BITMAP_WORDS(total); w++) {
+        uint64_t word = rows[w];
+        while (word) {
+            int row = w * 64 + __builtin_ctzll(word);
+            const HandleSlot* slot = &store->product_handles.slots[table->slots[row]];
+            int at = first_position[slot->parent_slot] + slot->array_index;
+            if (at >= 0 && at < total) {
+                positions[at / 64] |= (uint64_t)1 << (at % 64);
+            }
+            word &= word - 1;
+        }
+    }
+    
+    // Read positions back in order, moving through the subgroups alongside
+    int cat_index = 0;
+    int sub_index = 0;
+    int sub_start = 0;
+    for (int w = 0; w < FILTER_BITMAP_WORDS(total) && result.count < matches; w++) {
+        uint64_t word = positions[w];
+        while (word) {
+            int at = w * 64 + __builtin_ctzll(word);
+            word &= word - 1;
+            
+            while (cat_index < store->category_count) {
+                const Category* cat = &store->categories[cat_index];
+                if (sub_index < cat->subgroup_count) {
+                    const Subgroup* sub = &cat->subgroups[sub_index];
+                    if (at < sub_start + sub->product_count) {
+                        result.products[result.count++] = sub->products[at - sub_start];
+                        break;
+                    }
+                    sub_start += sub->product_count;
+                    sub_index++;
+                } else {
+                    cat_index++;
+                    sub_index = 0;
+                }
+            }
         }
-    } else if (count == 0) {
-        free(result.products);
-        result.products = NULL;
     }
     
-    result.count = count;
+    free(first_position);
+    free(positions);
     return result;
 }
 
-SearchResult datastore_search_products_by_quantity(DataStore* store, int min_qty, int max_qty) {
+/**
+ * @brief Filter every row on the calling thread
+ */
+static SearchResult search_rows(DataStore* store, const ProductTable* table, const SearchQuery* query) {
     SearchResult result = {NULL, 0};
+    int count = table->product_count;
     
-    if (!store) return result;
+    uint64_t* bitmap = (uint64_t*)malloc(FILTER_BITMAP_WORDS(count) * sizeof(uint64_t));
+    if (!bitmap) {
+        fprintf(stderr, "Error: Failed to allocate memory for search results\n");
+        return result;
+    }
     
-    int max_products = 0;
-    for (int i = 0; i < store->category_count; i++) {
-        for (int j = 0; j < store->categories[i].subgroup_count; j++) {
-            max_products += store->categories[i].subgroups[j].product_count;
-        }
+    int matches = search_filter_rows(table, query, 0, count, bitmap);
+    result = collect_matches(store, table, bitmap, matches);
+    free(bitmap);
+    return result;
+}
+
+/**
+ * @brief Split the table into chunks of target rows
+ * @param target Rows per chunk (the last chunk may be shorter)
+ * @param parts Maximum number of chunks; the last one takes any remainder
+ * @param bounds Output, chunk i is rows [bounds[i], bounds[i + 1]); needs parts + 1 entries
+ * @return Number of chunks
+ */
+static int partition_rows(const ProductTable* table, int target, int parts, int* bounds) {
+    int chunks = 0;
+    
+    bounds[0] = 0;
+    while (chunks < parts - 1 && bounds[chunks] + target < table->product_count) {
+        bounds[chunks + 1] = bounds[chunks] + target;
+        chunks++;
     }
+    bounds[++chunks] = table->product_count;
     
-    if (max_products == 0) return result;
+    return chunks;
+}
+
+typedef struct {
+    const ProductTable* table;
+    const SearchQuery* query;
+    const int* bounds;         // Chunk starts are multiples of 64 rows
+    uint64_t* bitmap;          // Shared; each chunk writes only its own words
+    int* matches;              // One count per chunk
+} ParallelSearch;
+
+static void parallel_search_task(void* context, int task_index) {
+    ParallelSearch* job = (ParallelSearch*)context;
+    int begin = job->bounds[task_index];
     
-    result.products = (Product*)malloc(max_products * sizeof(Product));
-    if (!result.products) {
-        fprintf(stderr, "Error: Failed to allocate memory for search results\n");
-        return result;
+    job->matches[task_index] = search_filter_rows(job->table, job->query, begin,
+                                                  job->bounds[task_index + 1] - begin,
+                                                  job->bitmap + begin / 64);
+}
+
+/**
+ * @brief Run a query over the whole table, in parallel when a pool is set
+ */
+static SearchResult search_table_locked(DataStore* store, const SearchQuery* query) {
+    SearchResult result = {NULL, 0};
+    
+    const ProductTable* table = datastore_get_product_table(store);
+    if (!table || table->product_count == 0) return result;
+    
+    int threads = thread_pool_size(store->pool);
+    if (threads <= 1 || table->product_count < PARALLEL_SCAN_MIN_PRODUCTS) {
+        return search_rows(store, table, query);
     }
     
-    int count = 0;
-    for (int i = 0; i < store->category_count; i++) {
-        for (int j = 0; j < store->categories[i].subgroup_count; j++) {
-            for (int k = 0; k < store->categories[i].subgroups[j].product_count; k++) {
-                Product* p = &store->categories[i].subgroups[j].products[k];
-                if (p->quantity >= min_qty && p->quantity <= max_qty) {
-                    result.products[count++] = *p;
-                }
-            }
-        }
+    // A few chunks per thread so one slow thread does not stall the rest
+    int parts = threads * 4;
+    int* bounds = (int*)malloc((parts + 1) * sizeof(int));
+    int* matches = (int*)calloc(parts, sizeof(int));
+    uint64_t* bitmap = (uint64_t*)malloc(FILTER_BITMAP_WORDS(table->product_count) * sizeof(uint64_t));
+    if (!bounds || !matches || !bitmap) {
+        free(bounds);
+        free(matches);
+        free(bitmap);
+        return search_rows(store, table, query);
     }
     
-    if (count < max_products && count > 0) {
-        Product* resized = (Product*)realloc(result.products, count * sizeof(Product));
-        if (resized) {
-            result.products = resized;
-        }
-    } else if (count == 0) {
-        free(result.products);
-        result.products = NULL;
+    // Whole bitmap words per chunk, so no two threads write the same word
+    int target = (table->product_count + parts - 1) / parts;
+    target = (target + 63) / 64 * 64;
+    int chunks = partition_rows(table, target, parts, bounds);
+    ParallelSearch job = {table, query, bounds, bitmap, matches};
+    thread_pool_run(store->pool, parallel_search_task, &job, chunks);
+    
+    int total = 0;
+    for (int i = 0; i < chunks; i++) {
+        total += matches[i];
     }
+    result = collect_matches(store, table, bitmap, total);
     
-    result.count = count;
+    free(bitmap);
+    free(matches);
+    free(bounds);
     return result;
 }
 
+static SearchResult datastore_search(DataStore* store, const SearchQuery* query, MetricId metric) {
+    MetricTimer timer = METRICS_START();
+    datastore_read_lock(store);
+    SearchResult result = search_table_locked(store, query);
+    datastore_read_unlock(store);
+    METRICS_STOP(metric, timer, true);
+    return result;
+}
+
+SearchResult datastore_search_products_by_name(DataStore* store, const char* name) {
+    SearchResult result = {NULL, 0};
+    
+    if (!store || !name) return result;
+    
+    SearchQuery query = {0};
+    query.kind = QUERY_NAME;
+    strncpy(query.needle, name, sizeof(query.needle) - 1);
+    query.needle[sizeof(query.needle) - 1] = '\0';
+    for (int i = 0; query.needle[i]; i++) {
+        query.needle[i] = tolower(query.needle[i]);
+    }
+    query.needle_len = strlen(query.needle);
+    
+    return datastore_search(store, &query, METRIC_DATASTORE_SEARCH_NAME);
+}
+
+SearchResult datastore_search_products_by_price(DataStore* store, float min_price, float max_price) {
+    SearchResult result = {NULL, 0};
+    
+    if (!store) return result;
+    
+    SearchQuery query = {0};
+    query.kind = QUERY_PRICE;
+    query.min_price = min_price;
+    query.max_price = max_price;
+    
+    return datastore_search(store, &query, METRIC_DATASTORE_SEARCH_PRICE);
+}
+
+SearchResult datastore_search_products_by_quantity(DataStore* store, int min_qty, int max_qty) {
+    SearchResult result = {NULL, 0};
+    
+    if (!store) return result;
+    
+    SearchQuery query = {0};
+    query.kind = QUERY_QUANTITY;
+    query.min_qty = min_qty;
+    query.max_qty = max_qty;
+    
+    return datastore_search(store, &query, METRIC_DATASTORE_SEARCH_QUANTITY);
+}
+
 void search_result_free(SearchResult* result) {
     if (!result) return;
     
@@ -504,104 +2256,301 @@ void search_result_free(SearchResult* result) {
     result->count = 0;
 }
 
-// ============================================================================
-// Statistics Functions
-// ============================================================================
-
+// ============================================================================
+// Statistics Functions
+// ============================================================================
+
+/**
+ * @brief Totals for one chunk of the scan table, kept wide so the merge loses nothing
+ */
+typedef struct {
+    double total_value;
+    double price_sum;
+    long long total_quantity;
+} StatisticsPartial;
+
+typedef struct {
+    const ProductTable* table;
+    const int* bounds;
+    StatisticsPartial* partials;    // One per chunk
+} ParallelStatistics;
+
+static void parallel_statistics_task(void* context, int task_index) {
+    ParallelStatistics* job = (ParallelStatistics*)context;
+    const float* prices = job->table->prices;
+    const int* quantities = job->table->quantities;
+    StatisticsPartial partial = {0.0, 0.0, 0};
+    
+    for (int i = job->bounds[task_index]; i < job->bounds[task_index + 1]; i++) {
+        partial.total_value += (double)prices[i] * quantities[i];
+        partial.total_quantity += quantities[i];
+        partial.price_sum += prices[i];
+    }
+    
+    job->partials[task_index] = partial;
+}
+
+static Statistics get_statistics_locked(DataStore* store) {
+    Statistics stats = {0, 0, 0, 0.0f, 0.0f, 0};
+    
+    stats.total_categories = store->category_count;
+    
+    const ProductTable* table = datastore_get_product_table(store);
+    if (!table) return stats;
+    
+    for (int i = 0; i < store->category_count; i++) {
+        stats.total_subgroups += store->categories[i].subgroup_count;
+    }
+    stats.total_products = table->product_count;
+    if (table->product_count == 0) return stats;
+    
+    // Chunk size is fixed and chunks are summed in order, so the serial and
+    // parallel paths give bit-identical totals for any thread count
+    int parts = (table->product_count + STATISTICS_CHUNK_PRODUCTS - 1) / STATISTICS_CHUNK_PRODUCTS;
+    int* bounds = (int*)malloc((parts + 1) * sizeof(int));
+    StatisticsPartial* partials = (StatisticsPartial*)malloc(parts * sizeof(StatisticsPartial));
+    if (!bounds || !partials) {
+        fprintf(stderr, "Error: Failed to allocate memory for statistics\n");
+        free(bounds);
+        free(partials);
+        return stats;
+    }
+    
+    int chunks = partition_rows(table, STATISTICS_CHUNK_PRODUCTS, parts, bounds);
+    ParallelStatistics job = {table, bounds, partials};
+    bool parallel = thread_pool_size(store->pool) > 1 &&
+                    table->product_count >= PARALLEL_SCAN_MIN_PRODUCTS;
+    thread_pool_run(parallel ? store->pool : NULL, parallel_statistics_task, &job, chunks);
+    
+    StatisticsPartial total = {0.0, 0.0, 0};
+    for (int i = 0; i < chunks; i++) {
+        total.total_value += partials[i].total_value;
+        total.total_quantity += partials[i].total_quantity;
+        total.price_sum += partials[i].price_sum;
+    }
+    
+    stats.total_value = (float)total.total_value;
+    stats.total_quantity = (int)total.total_quantity;
+    stats.average_price = (float)(total.price_sum / stats.total_products);
+    
+    free(partials);
+    free(bounds);
+    return stats;
+}
+
 Statistics datastore_get_statistics(DataStore* store) {
     Statistics stats = {0, 0, 0, 0.0f, 0.0f, 0};
     
     if (!store) return stats;
     
-    stats.total_categories = store->category_count;
-    
-    float total_price_sum = 0.0f;
-    
+    MetricTimer timer = METRICS_START();
+    datastore_read_lock(store);
+    stats = get_statistics_locked(store);
+    datastore_read_unlock(store);
+    METRICS_STOP(METRIC_DATASTORE_STATISTICS, timer, true);
+    return stats;
+}
+
+// ============================================================================
+// Memory Accounting
+// ============================================================================
+
+static void usage_add(MemoryUsage* usage, size_t used, size_t reserved, const void* block) {
+    usage->used += used;
+    usage->reserved += reserved;
+    if (block) usage->allocations++;
+}
+
+/**
+ * @brief Characters stored in a fixed-size text field, terminator included
+ */
+static size_t text_used(const char* field, size_t size) {
+    const char* end = memchr(field, '\0', size);
+    return end ? (size_t)(end - field) + 1 : size;
+}
+
+static void handle_table_usage(MemoryUsage* usage, const HandleTable* table) {
+    usage_add(usage, table->slot_count * sizeof(HandleSlot),
+              table->slot_capacity * sizeof(HandleSlot), table->slots);
+    usage_add(usage, table->id_map_count * sizeof(HandleIdEntry),
+              table->id_map_capacity * sizeof(HandleIdEntry), table->id_map);
+}
+
+static void scan_table_usage(MemoryUsage* usage, const ProductTable* table) {
+    size_t row = sizeof(int) + sizeof(float) + sizeof(int) + PRODUCT_NAME_SIZE;
+    usage_add(usage, table->product_count * row, table->product_capacity * row, NULL);
+    usage->allocations += (table->slots != NULL) + (table->prices != NULL) +
+                          (table->quantities != NULL) + (table->names_folded != NULL);
+    
+    // Every index entry up to the highest slot is needed to find rows
+    usage_add(usage, table->slot_capacity * sizeof(int),
+              table->slot_capacity * sizeof(int), table->row_of_slot);
+}
+
+static MemoryReport memory_report_locked(DataStore* store) {
+    MemoryReport report;
+    memset(&report, 0, sizeof(report));
+
+    usage_add(&report.categories, store->category_count * sizeof(Category),
+              store->category_capacity * sizeof(Category), store->categories);
+
     for (int i = 0; i < store->category_count; i++) {
-        stats.total_subgroups += store->categories[i].subgroup_count;
-        
-        for (int j = 0; j < store->categories[i].subgroup_count; j++) {
-            stats.total_products += store->categories[i].subgroups[j].product_count;
-            
-            for (int k = 0; k < store->categories[i].subgroups[j].product_count; k++) {
-                Product* p = &store->categories[i].subgroups[j].products[k];
-                stats.total_value += p->price * p->quantity;
-                stats.total_quantity += p->quantity;
-                total_price_sum += p->price;
+        const Category* cat = &store->categories[i];
+        usage_add(&report.subgroups, cat->subgroup_count * sizeof(Subgroup),
+                  cat->subgroup_capacity * sizeof(Subgroup), cat->subgroups);
+        usage_add(&report.strings, text_used(cat->name, sizeof(cat->name)) +
+                                   text_used(cat->description, sizeof(cat->description)),
+                  sizeof(cat->name) + sizeof(cat->description), NULL);
+
+        for (int j = 0; j < cat->subgroup_count; j++) {
+            const Subgroup* sub = &cat->subgroups[j];
+            usage_add(&report.products, sub->product_count * sizeof(Product),
+                      sub->product_capacity * sizeof(Product), sub->products);
+            usage_add(&report.strings, text_used(sub->name, sizeof(sub->name)) +
+                                       text_used(sub->description, sizeof(sub->description)),
+                      sizeof(sub->name) + sizeof(sub->description), NULL);
+
+            for (int k = 0; k < sub->product_count; k++) {
+                const Product* prod = &sub->products[k];
+                usage_add(&report.strings,
+                          text_used(prod->code, sizeof(prod->code)) +
+                          text_used(prod->name, sizeof(prod->name)) +
+                          text_used(prod->description, sizeof(prod->description)),
+                          sizeof(prod->code) + sizeof(prod->name) + sizeof(prod->description), NULL);
             }
         }
     }
-    
-    if (stats.total_products > 0) {
-        stats.average_price = total_price_sum / stats.total_products;
+
+    handle_table_usage(&report.handles, &store->category_handles);
+    handle_table_usage(&report.handles, &store->subgroup_handles);
+    handle_table_usage(&report.handles, &store->product_handles);
+
+    // Other readers may be rebuilding the scan table under scan_lock
+    if (store->lock) mutex_lock(&store->lock->scan_lock);
+    scan_table_usage(&report.scan_table, &store->scan_table);
+    if (store->lock) mutex_unlock(&store->lock->scan_lock);
+
+    if (store->snapshots) {
+        snapshot_domain_memory(store->snapshots, &report.snapshots.used,
+                               &report.snapshots.reserved, &report.snapshots.allocations);
     }
-    
-    return stats;
+
+    const MemoryUsage* levels[] = { &report.categories, &report.subgroups, &report.products,
+                                    &report.handles, &report.scan_table, &report.snapshots };
+    for (size_t i = 0; i < sizeof(levels) / sizeof(levels[0]); i++) {
+        report.total.used += levels[i]->used;
+        report.total.reserved += levels[i]->reserved;
+        report.total.allocations += levels[i]->allocations;
+    }
+    return report;
+}
+
+MemoryReport datastore_memory_report(DataStore* store) {
+    MemoryReport report;
+    memset(&report, 0, sizeof(report));
+    if (!store) return report;
+
+    datastore_read_lock(store);
+    report = memory_report_locked(store);
+    datastore_read_unlock(store);
+    return report;
+}
+
+static void display_memory_row(const char* label, const MemoryUsage* usage) {
+    double used = usage->used / 1048576.0;
+    double reserved = usage->reserved / 1048576.0;
+    double slack = reserved > 0 ? 100.0 * (reserved - used) / reserved : 0.0;
+    render_printf("  │ %-12s │ %11.2f │ %11.2f │ %6.1f%% │ %11lld │\n",
+                  label, used, reserved, slack, usage->allocations);
+}
+
+void datastore_display_memory(DataStore* store) {
+    MemoryReport report = datastore_memory_report(store);
+
+    render_begin();
+    render_printf("  ┌──────────────┬─────────────┬─────────────┬─────────┬─────────────┐\n");
+    render_printf("  │ Level        │ Used (MB)   │ Alloc (MB)  │ Slack   │ Allocations │\n");
+    render_printf("  ├──────────────┼─────────────┼─────────────┼─────────┼─────────────┤\n");
+    display_memory_row("Categories", &report.categories);
+    display_memory_row("Subgroups", &report.subgroups);
+    display_memory_row("Products", &report.products);
+    display_memory_row("Handles", &report.handles);
+    display_memory_row("Scan table", &report.scan_table);
+    display_memory_row("Snapshots", &report.snapshots);
+    render_printf("  ├──────────────┼─────────────┼─────────────┼─────────┼─────────────┤\n");
+    display_memory_row("Total", &report.total);
+    display_memory_row("(Strings)", &report.strings);
+    render_printf("  └──────────────┴─────────────┴─────────────┴─────────┴─────────────┘\n");
+    render_end();
 }
 
 // ============================================================================
 // Display Functions
 // ============================================================================
 
-void datastore_display_all(DataStore* store) {
-    if (!store) {
-        set_color(COLOR_ERROR);
-        printf("Error: DataStore pointer is NULL\n");
-        set_color(COLOR_RESET);
-        return;
-    }
-    
+static void display_category_heading(const Category* cat) {
+    set_color(COLOR_HEADER);
+    render_printf("╔══════════════════════════════════════════════════════════╗\n");
+    render_printf("║ Category: %-47s║\n", cat->name);
+    render_printf("║ ID: %-52d ║\n", cat->id);
+    render_printf("╚══════════════════════════════════════════════════════════╝\n");
+    set_color(COLOR_RESET);
+    render_printf("  Description: %s\n", cat->description);
+    render_printf("  Subgroups: %d\n\n", cat->subgroup_count);
+}
+
+static void display_subgroup_heading(const Subgroup* sub) {
+    set_color(COLOR_INFO);
+    render_printf("  ► Subgroup: %s (ID: %d)\n", sub->name, sub->id);
+    set_color(COLOR_RESET);
+    render_printf("    Description: %s\n", sub->description);
+    render_printf("    Products: %d\n\n", sub->product_count);
+}
+
+static void display_hierarchy(const Category* categories, int category_count,
+                              const char* last_saved, bool is_modified) {
     clear_screen();
+    render_begin();
     set_color(COLOR_HEADER);
-    printf("\n╔══════════════════════════════════════════════════════════╗\n");
-    printf("║              ALL DATA - HIERARCHICAL VIEW                ║\n");
-    printf("╚══════════════════════════════════════════════════════════╝\n\n");
+    render_printf("\n╔══════════════════════════════════════════════════════════╗\n");
+    render_printf("║              ALL DATA - HIERARCHICAL VIEW                ║\n");
+    render_printf("╚══════════════════════════════════════════════════════════╝\n\n");
     set_color(COLOR_RESET);
     
-    if (store->category_count == 0) {
-        printf("  No data available.\n\n");
+    if (category_count == 0) {
+        render_printf("  No data available.\n\n");
+        render_end();
         return;
     }
     
     set_color(COLOR_INFO);
-    printf("  Total Categories: %d\n", store->category_count);
-    printf("  Last Saved: %s\n", store->last_saved ? store->last_saved : "Not saved yet");
-    printf("  Modified: %s\n\n", store->is_modified ? "Yes" : "No");
+    render_printf("  Total Categories: %d\n", category_count);
+    render_printf("  Last Saved: %s\n", last_saved ? last_saved : "Not saved yet");
+    render_printf("  Modified: %s\n\n", is_modified ? "Yes" : "No");
     set_color(COLOR_RESET);
     
-    for (int i = 0; i < store->category_count; i++) {
-        Category* cat = &store->categories[i];
+    for (int i = 0; i < category_count; i++) {
+        const Category* cat = &categories[i];
         
-        set_color(COLOR_HEADER);
-        printf("╔══════════════════════════════════════════════════════════╗\n");
-        printf("║ Category: %-47s║\n", cat->name);
-        printf("║ ID: %-52d ║\n", cat->id);
-        printf("╚══════════════════════════════════════════════════════════╝\n");
-        set_color(COLOR_RESET);
-        printf("  Description: %s\n", cat->description);
-        printf("  Subgroups: %d\n\n", cat->subgroup_count);
+        display_category_heading(cat);
         
         if (cat->subgroup_count > 0) {
-            printf("  Subgroups in this category:\n");
+            render_printf("  Subgroups in this category:\n");
             subgroup_display_table_header();
             for (int j = 0; j < cat->subgroup_count; j++) {
                 subgroup_display_table_row(&cat->subgroups[j]);
             }
             subgroup_display_table_footer();
-            printf("\n");
+            render_printf("\n");
         } else {
             set_color(COLOR_WARNING);
-            printf("  No subgroups in this category.\n\n");
+            render_printf("  No subgroups in this category.\n\n");
             set_color(COLOR_RESET);
         }
         
         for (int j = 0; j < cat->subgroup_count; j++) {
-            Subgroup* sub = &cat->subgroups[j];
-            set_color(COLOR_INFO);
-            printf("  ► Subgroup: %s (ID: %d)\n", sub->name, sub->id);
-            set_color(COLOR_RESET);
-            printf("    Description: %s\n", sub->description);
-            printf("    Products: %d\n\n", sub->product_count);
+            const Subgroup* sub = &cat->subgroups[j];
+            display_subgroup_heading(sub);
             
             if (sub->product_count > 0) {
                 product_display_table_header();
@@ -609,63 +2558,331 @@ void datastore_display_all(DataStore* store) {
                     product_display_table_row(&sub->products[k]);
                 }
                 product_display_table_footer();
-                printf("\n");
+                render_printf("\n");
             } else {
                 set_color(COLOR_WARNING);
-                printf("    No products in this subgroup.\n\n");
+                render_printf("    No products in this subgroup.\n\n");
                 set_color(COLOR_RESET);
             }
         }
     }
+    render_end();
+}
+
+void datastore_display_all(DataStore* store) {
+    if (!store) {
+        set_color(COLOR_ERROR);
+        printf("Error: DataStore pointer is NULL\n");
+        set_color(COLOR_RESET);
+        return;
+    }
+    
+    // A pinned snapshot lets the whole listing print without holding up writers
+    SnapshotPin pin;
+    if (datastore_snapshot_pin(store, &pin)) {
+        const Snapshot* snapshot = pin.snapshot;
+        display_hierarchy(snapshot->categories, snapshot->category_count,
+                          snapshot->info.last_saved, snapshot->info.is_modified);
+        datastore_snapshot_unpin(store, &pin);
+        return;
+    }
+    
+    datastore_read_lock(store);
+    display_hierarchy(store->categories, store->category_count, store->last_saved, store->is_modified);
+    datastore_read_unlock(store);
 }
 
 // ============================================================================
-// File I/O Functions (COMPLETE)
+// Paged Listings
 // ============================================================================
 
-bool datastore_save(DataStore* store, const char* filename) {
-    if (!store || !filename) {
-        fprintf(stderr, "Error: Invalid parameters for save\n");
-        return false;
+void page_cursor_init(PageCursor* cursor, int page_size) {
+    if (!cursor) return;
+    cursor->offset = 0;
+    cursor->page_size = page_size > 0 ? page_size : LISTING_PAGE_SIZE;
+    cursor->total = 0;
+}
+
+int page_cursor_page(const PageCursor* cursor) {
+    return cursor ? cursor->offset / cursor->page_size : 0;
+}
+
+int page_cursor_page_count(const PageCursor* cursor) {
+    if (!cursor || cursor->total <= 0) return 1;
+    return (cursor->total - 1) / cursor->page_size + 1;
+}
+
+void page_cursor_seek(PageCursor* cursor, int page) {
+    if (!cursor) return;
+    int last = page_cursor_page_count(cursor) - 1;
+    if (page > last) page = last;
+    if (page < 0) page = 0;
+    cursor->offset = page * cursor->page_size;
+}
+
+bool page_cursor_move(PageCursor* cursor, int pages) {
+    if (!cursor) return false;
+    int before = cursor->offset;
+    long long target = (long long)page_cursor_page(cursor) + pages;
+    if (target > INT_MAX) target = INT_MAX;
+    if (target < 0) target = 0;
+    page_cursor_seek(cursor, (int)target);
+    return cursor->offset != before;
+}
+
+/**
+ * @brief Adopt the current product count, keeping the cursor on a page that exists
+ */
+static void page_cursor_update(PageCursor* cursor, int total) {
+    cursor->total = total;
+    page_cursor_seek(cursor, page_cursor_page(cursor));
+}
+
+static void display_page_position(const PageCursor* cursor) {
+    int first = cursor->total > 0 ? cursor->offset + 1 : 0;
+    int last = cursor->offset + cursor->page_size;
+    if (last > cursor->total) last = cursor->total;
+
+    set_color(COLOR_INFO);
+    render_printf("  Page %d of %d  (products %d-%d of %d)\n\n",
+                  page_cursor_page(cursor) + 1, page_cursor_page_count(cursor),
+                  first, last, cursor->total);
+    set_color(COLOR_RESET);
+}
+
+static int count_products(const Category* categories, int category_count) {
+    int total = 0;
+    for (int i = 0; i < category_count; i++) {
+        for (int j = 0; j < categories[i].subgroup_count; j++) {
+            total += categories[i].subgroups[j].product_count;
+        }
+    }
+    return total;
+}
+
+static void display_products_page(const Category* categories, int category_count, PageCursor* cursor) {
+    page_cursor_update(cursor, count_products(categories, category_count));
+
+    render_begin();
+    if (cursor->total == 0) {
+        render_printf("  No products found.\n\n");
+        render_end();
+        return;
+    }
+
+    display_page_position(cursor);
+    int start = cursor->offset;
+    int end = start + cursor->page_size;
+    if (end > cursor->total) end = cursor->total;
+
+    // Whole subgroups before the page are skipped by their counts alone
+    product_display_table_header();
+    int position = 0;
+    for (int i = 0; i < category_count && position < end; i++) {
+        for (int j = 0; j < categories[i].subgroup_count && position < end; j++) {
+            const Subgroup* sub = &categories[i].subgroups[j];
+            int first = position;
+            position += sub->product_count;
+            if (position <= start) continue;
+
+            int from = start > first ? start - first : 0;
+            int to = end < position ? end - first : sub->product_count;
+            for (int k = from; k < to; k++) {
+                product_display_table_row(&sub->products[k]);
+            }
+        }
+    }
+    product_display_table_footer();
+    render_printf("\n");
+    render_end();
+}
+
+void datastore_display_products_page(DataStore* store, PageCursor* cursor) {
+    if (!store || !cursor) return;
+
+    SnapshotPin pin;
+    if (datastore_snapshot_pin(store, &pin)) {
+        display_products_page(pin.snapshot->categories, pin.snapshot->category_count, cursor);
+        datastore_snapshot_unpin(store, &pin);
+        return;
+    }
+
+    datastore_read_lock(store);
+    display_products_page(store->categories, store->category_count, cursor);
+    datastore_read_unlock(store);
+}
+
+/**
+ * @brief Whether an empty subgroup or category at a position belongs on the page
+ *
+ * Each position falls on exactly one page; one past the last product
+ * belongs to the last page.
+ */
+static bool page_holds_position(int position, int start, int end, int total) {
+    return (position >= start && position < end) || (position == total && end == total);
+}
+
+static void display_hierarchy_page(const Category* categories, int category_count,
+                                   const char* last_saved, bool is_modified,
+                                   PageCursor* cursor) {
+    int total = count_products(categories, category_count);
+    page_cursor_update(cursor, total);
+
+    render_begin();
+    if (category_count == 0) {
+        render_printf("  No data available.\n\n");
+        render_end();
+        return;
+    }
+
+    set_color(COLOR_INFO);
+    render_printf("  Total Categories: %d\n", category_count);
+    render_printf("  Last Saved: %s\n", last_saved ? last_saved : "Not saved yet");
+    render_printf("  Modified: %s\n", is_modified ? "Yes" : "No");
+    set_color(COLOR_RESET);
+    display_page_position(cursor);
+
+    int start = cursor->offset;
+    int end = start + cursor->page_size;
+    if (end > total) end = total;
+
+    // Whole subgroups before the page are skipped by their counts alone
+    int position = 0;
+    for (int i = 0; i < category_count && position <= end; i++) {
+        const Category* cat = &categories[i];
+
+        if (cat->subgroup_count == 0) {
+            if (page_holds_position(position, start, end, total)) {
+                display_category_heading(cat);
+                set_color(COLOR_WARNING);
+                render_printf("  No subgroups in this category.\n\n");
+                set_color(COLOR_RESET);
+            }
+            continue;
+        }
+
+        bool heading_shown = false;
+        for (int j = 0; j < cat->subgroup_count && position <= end; j++) {
+            const Subgroup* sub = &cat->subgroups[j];
+            int first = position;
+            position += sub->product_count;
+
+            bool visible = sub->product_count > 0 ? (first < end && position > start)
+                                                  : page_holds_position(first, start, end, total);
+            if (!visible) continue;
+
+            if (!heading_shown) {
+                display_category_heading(cat);
+                heading_shown = true;
+            }
+            display_subgroup_heading(sub);
+
+            if (sub->product_count > 0) {
+                int from = start > first ? start - first : 0;
+                int to = end < position ? end - first : sub->product_count;
+                product_display_table_header();
+                for (int k = from; k < to; k++) {
+                    product_display_table_row(&sub->products[k]);
+                }
+                product_display_table_footer();
+                render_printf("\n");
+            } else {
+                set_color(COLOR_WARNING);
+                render_printf("    No products in this subgroup.\n\n");
+                set_color(COLOR_RESET);
+            }
+        }
     }
+    render_end();
+}
+
+void datastore_display_hierarchy_page(DataStore* store, PageCursor* cursor) {
+    if (!store || !cursor) return;
+
+    SnapshotPin pin;
+    if (datastore_snapshot_pin(store, &pin)) {
+        const Snapshot* snapshot = pin.snapshot;
+        display_hierarchy_page(snapshot->categories, snapshot->category_count,
+                               snapshot->info.last_saved, snapshot->info.is_modified, cursor);
+        datastore_snapshot_unpin(store, &pin);
+        return;
+    }
+
+    datastore_read_lock(store);
+    display_hierarchy_page(store->categories, store->category_count,
+                           store->last_saved, store->is_modified, cursor);
+    datastore_read_unlock(store);
+}
+
+// ============================================================================
+// File I/O Functions (COMPLETE)
+// ============================================================================
+
+/**
+ * @brief Backup name for a data file: extension replaced by .bak
+ *
+ * data/products.dat keeps its data/products.bak backup, and every shard
+ * file gets its own.
+ */
+static void backup_path_for(const char* filename, char* buffer, size_t size) {
+    snprintf(buffer, size, "%s", filename);
     
-    // Create temp file name
+    char* dot = strrchr(buffer, '.');
+    char* slash = strrchr(buffer, '/');
+    char* backslash = strrchr(buffer, '\\');
+    if (backslash && (!slash || backslash > slash)) slash = backslash;
+    
+    if (dot && (!slash || dot > slash)) {
+        *dot = '\0';
+    }
+    size_t length = strlen(buffer);
+    snprintf(buffer + length, size - length, ".bak");
+}
+
+/**
+ * @brief Write the hierarchy to filename through a temp file, keeping a backup
+ */
+static bool write_data_file(const char* filename, const SnapshotInfo* info,
+                            const Category* categories, int category_count) {
+    // Create temp and backup file names
     char temp_file[512];
+    char backup_file[512];
     snprintf(temp_file, sizeof(temp_file), "%s.tmp", filename);
+    backup_path_for(filename, backup_file, sizeof(backup_file));
     
     // Write to temp file first
     FILE* file = fopen(temp_file, "wb");
     if (!file) {
-        set_color(COLOR_ERROR);
+        set_stream_color(stderr, COLOR_ERROR);
         fprintf(stderr, "Error: Cannot create temporary file %s\n", temp_file);
-        set_color(COLOR_RESET);
+        set_stream_color(stderr, COLOR_RESET);
         return false;
     }
     
     // Write and validate header
-    if (fwrite(&store->category_count, sizeof(int), 1, file) != 1 ||
-        fwrite(&store->next_category_id, sizeof(int), 1, file) != 1 ||
-        fwrite(&store->next_subgroup_id, sizeof(int), 1, file) != 1 ||
-        fwrite(&store->next_product_id, sizeof(int), 1, file) != 1) {
-        set_color(COLOR_ERROR);
+    if (fwrite(&category_count, sizeof(int), 1, file) != 1 ||
+        fwrite(&info->next_category_id, sizeof(int), 1, file) != 1 ||
+        fwrite(&info->next_subgroup_id, sizeof(int), 1, file) != 1 ||
+        fwrite(&info->next_product_id, sizeof(int), 1, file) != 1) {
+        set_stream_color(stderr, COLOR_ERROR);
         fprintf(stderr, "Error: Failed to write header\n");
-        set_color(COLOR_RESET);
+        set_stream_color(stderr, COLOR_RESET);
         fclose(file);
         remove(temp_file);
         return false;
     }
     
     // Write each category with validation
-    for (int i = 0; i < store->category_count; i++) {
-        Category* cat = &store->categories[i];
+    for (int i = 0; i < category_count; i++) {
+        const Category* cat = &categories[i];
         
         if (fwrite(&cat->id, sizeof(int), 1, file) != 1 ||
             fwrite(cat->name, sizeof(char), 50, file) != 50 ||
             fwrite(cat->description, sizeof(char), 200, file) != 200 ||
             fwrite(&cat->subgroup_count, sizeof(int), 1, file) != 1) {
-            set_color(COLOR_ERROR);
+            set_stream_color(stderr, COLOR_ERROR);
             fprintf(stderr, "Error: Failed to write category %d\n", cat->id);
-            set_color(COLOR_RESET);
+            set_stream_color(stderr, COLOR_RESET);
             fclose(file);
             remove(temp_file);
             return false;
@@ -673,16 +2890,16 @@ bool datastore_save(DataStore* store, const char* filename) {
         
         // Write each subgroup
         for (int j = 0; j < cat->subgroup_count; j++) {
-            Subgroup* sub = &cat->subgroups[j];
+            const Subgroup* sub = &cat->subgroups[j];
             
             if (fwrite(&sub->id, sizeof(int), 1, file) != 1 ||
                 fwrite(&sub->category_id, sizeof(int), 1, file) != 1 ||
                 fwrite(sub->name, sizeof(char), 50, file) != 50 ||
                 fwrite(sub->description, sizeof(char), 200, file) != 200 ||
                 fwrite(&sub->product_count, sizeof(int), 1, file) != 1) {
-                set_color(COLOR_ERROR);
+                set_stream_color(stderr, COLOR_ERROR);
                 fprintf(stderr, "Error: Failed to write subgroup %d\n", sub->id);
-                set_color(COLOR_RESET);
+                set_stream_color(stderr, COLOR_RESET);
                 fclose(file);
                 remove(temp_file);
                 return false;
@@ -690,11 +2907,11 @@ bool datastore_save(DataStore* store, const char* filename) {
             
             // Write each product
             for (int k = 0; k < sub->product_count; k++) {
-                Product* prod = &sub->products[k];
+                const Product* prod = &sub->products[k];
                 if (fwrite(prod, sizeof(Product), 1, file) != 1) {
-                    set_color(COLOR_ERROR);
+                    set_stream_color(stderr, COLOR_ERROR);
                     fprintf(stderr, "Error: Failed to write product %d\n", prod->id);
-                    set_color(COLOR_RESET);
+                    set_stream_color(stderr, COLOR_RESET);
                     fclose(file);
                     remove(temp_file);
                     return false;
@@ -706,27 +2923,104 @@ bool datastore_save(DataStore* store, const char* filename) {
     fclose(file);
     
     // Atomic file replacement
-    remove(BACKUP_FILE);
-    rename(filename, BACKUP_FILE);
+    remove(backup_file);
+    rename(filename, backup_file);
     
     if (rename(temp_file, filename) != 0) {
-        set_color(COLOR_ERROR);
+        set_stream_color(stderr, COLOR_ERROR);
         fprintf(stderr, "Error: Failed to finalize save\n");
-        set_color(COLOR_RESET);
-        rename(BACKUP_FILE, filename);
+        set_stream_color(stderr, COLOR_RESET);
+        rename(backup_file, filename);
         return false;
     }
     
+    return true;
+}
+
+/**
+ * @brief Update the store after a successful save of the given version
+ */
+static void finish_save(DataStore* store, const char* filename, unsigned long saved_version) {
     get_current_timestamp(store->last_saved, sizeof(store->last_saved));
-    store->is_modified = false;
     
+    // Changes published while a snapshot was being written keep the flag set
+    if (store->version == saved_version) {
+        store->is_modified = false;
+    }
+    publish_snapshot(store);
+    
+    if (store->quiet) return;
     set_color(COLOR_SUCCESS);
     printf("✓ Data saved successfully to %s\n", filename);
     set_color(COLOR_RESET);
+}
+
+static bool save_locked(DataStore* store, const char* filename) {
+    SnapshotInfo info;
+    info.next_category_id = atomic_load(&store->next_category_id);
+    info.next_subgroup_id = atomic_load(&store->next_subgroup_id);
+    info.next_product_id = atomic_load(&store->next_product_id);
+    
+    if (!write_data_file(filename, &info, store->categories, store->category_count)) {
+        return false;
+    }
+    
+    finish_save(store, filename, store->version);
     return true;
 }
 
-bool datastore_load(DataStore* store, const char* filename) {
+/**
+ * @brief Save from a pinned snapshot so writers keep going while the file is written
+ */
+static bool save_snapshot(DataStore* store, const char* filename) {
+    SnapshotPin pin;
+    if (!datastore_snapshot_pin(store, &pin)) {
+        return false;
+    }
+    
+    // Saves still exclude each other, they share the temp and backup files
+    mutex_lock(&store->lock->save_lock);
+    
+    const Snapshot* snapshot = pin.snapshot;
+    unsigned long saved_version = snapshot->info.version;
+    bool ok = write_data_file(filename, &snapshot->info, snapshot->categories, snapshot->category_count);
+    datastore_snapshot_unpin(store, &pin);
+    
+    if (ok) {
+        datastore_write_lock(store);
+        finish_save(store, filename, saved_version);
+        datastore_write_unlock(store);
+    }
+    
+    mutex_unlock(&store->lock->save_lock);
+    return ok;
+}
+
+static bool save_data_file(DataStore* store, const char* filename) {
+    if (!store || !filename) {
+        fprintf(stderr, "Error: Invalid parameters for save\n");
+        return false;
+    }
+    
+    if (store->snapshots) {
+        return save_snapshot(store, filename);
+    }
+    
+    // Also updates last_saved and is_modified
+    datastore_write_lock(store);
+    bool ok = save_locked(store, filename);
+    datastore_write_unlock(store);
+    return ok;
+}
+
+bool datastore_save(DataStore* store, const char* filename) {
+    MetricTimer timer = METRICS_START();
+    bool ok = save_data_file(store, filename);
+    METRICS_STOP(METRIC_DATASTORE_SAVE, timer, ok);
+    return ok;
+}
+
+static bool load_locked(DataStore* store, const char* filename) {
     if (!store || !filename) {
         fprintf(stderr, "Error: Invalid parameters for load\n");
         return false;
@@ -734,48 +3028,62 @@ bool datastore_load(DataStore* store, const char* filename) {
     
     FILE* file = fopen(filename, "rb");
     if (!file) {
-        set_color(COLOR_INFO);
-        printf("ℹ No existing data file found. Starting with empty database.\n");
-        set_color(COLOR_RESET);
+        if (!store->quiet) {
+            set_color(COLOR_INFO);
+            printf("ℹ No existing data file found. Starting with empty database.\n");
+            set_color(COLOR_RESET);
+        }
         return true;
     }
     
-    // Free existing data
-    datastore_free(store);
+    // Free existing data, keeping the worker pool, locks and settings
+    ThreadPool* pool = store->pool;
+    DataStoreLock* lock = store->lock;
+    SnapshotDomain* snapshots = store->snapshots;
+    bool quiet = store->quiet;
+    bool ids_striped = store->ids_striped;
+    datastore_free_data(store);
     *store = datastore_init();
+    store->pool = pool;
+    store->lock = lock;
+    store->snapshots = snapshots;
+    store->quiet = quiet;
+    store->ids_striped = ids_striped;
     
     // Read and validate header
+    int next_ids[3];
     if (fread(&store->category_count, sizeof(int), 1, file) != 1 ||
-        fread(&store->next_category_id, sizeof(int), 1, file) != 1 ||
-        fread(&store->next_subgroup_id, sizeof(int), 1, file) != 1 ||
-        fread(&store->next_product_id, sizeof(int), 1, file) != 1) {
-        set_color(COLOR_ERROR);
+        fread(next_ids, sizeof(int), 3, file) != 3) {
+        set_stream_color(stderr, COLOR_ERROR);
         fprintf(stderr, "✗ Error: Corrupted file header\n");
-        set_color(COLOR_RESET);
+        set_stream_color(stderr, COLOR_RESET);
         fclose(file);
         return false;
     }
     
     // Validate header data
     if (store->category_count < 0 || store->category_count > 10000 ||
-        store->next_category_id <= 0 || store->next_subgroup_id <= 0 || 
-        store->next_product_id <= 0) {
-        set_color(COLOR_ERROR);
+        next_ids[0] <= 0 || next_ids[1] <= 0 || next_ids[2] <= 0) {
+        set_stream_color(stderr, COLOR_ERROR);
         fprintf(stderr, "✗ Error: Invalid data in file header\n");
-        set_color(COLOR_RESET);
+        set_stream_color(stderr, COLOR_RESET);
         fclose(file);
         return false;
     }
     
+    atomic_store(&store->next_category_id, next_ids[0]);
+    atomic_store(&store->next_subgroup_id, next_ids[1]);
+    atomic_store(&store->next_product_id, next_ids[2]);
+    
     // Allocate category array
     store->category_capacity = store->category_count > INITIAL_CATEGORY_CAPACITY ? 
                                store->category_count : INITIAL_CATEGORY_CAPACITY;
     store->categories = (Category*)malloc(store->category_capacity * sizeof(Category));
     
     if (!store->categories) {
-        set_color(COLOR_ERROR);
+        set_stream_color(stderr, COLOR_ERROR);
         fprintf(stderr, "✗ Error: Failed to allocate memory for categories\n");
-        set_color(COLOR_RESET);
+        set_stream_color(stderr, COLOR_RESET);
         fclose(file);
         return false;
     }
@@ -788,20 +3096,20 @@ bool datastore_load(DataStore* store, const char* filename) {
             fread(cat->name, sizeof(char), 50, file) != 50 ||
             fread(cat->description, sizeof(char), 200, file) != 200 ||
             fread(&cat->subgroup_count, sizeof(int), 1, file) != 1) {
-            set_color(COLOR_ERROR);
+            set_stream_color(stderr, COLOR_ERROR);
             fprintf(stderr, "✗ Error: Failed to read category %d\n", i);
-            set_color(COLOR_RESET);
+            set_stream_color(stderr, COLOR_RESET);
             fclose(file);
-            datastore_free(store);
+            datastore_free_data(store);
             return false;
         }
         
         if (cat->subgroup_count < 0 || cat->subgroup_count > 1000) {
-            set_color(COLOR_ERROR);
+            set_stream_color(stderr, COLOR_ERROR);
             fprintf(stderr, "✗ Error: Invalid subgroup count in category\n");
-            set_color(COLOR_RESET);
+            set_stream_color(stderr, COLOR_RESET);
             fclose(file);
-            datastore_free(store);
+            datastore_free_data(store);
             return false;
         }
         
@@ -810,11 +3118,11 @@ bool datastore_load(DataStore* store, const char* filename) {
         cat->subgroups = (Subgroup*)malloc(cat->subgroup_capacity * sizeof(Subgroup));
         
         if (!cat->subgroups) {
-            set_color(COLOR_ERROR);
+            set_stream_color(stderr, COLOR_ERROR);
             fprintf(stderr, "✗ Error: Failed to allocate memory for subgroups\n");
-            set_color(COLOR_RESET);
+            set_stream_color(stderr, COLOR_RESET);
             fclose(file);
-            datastore_free(store);
+            datastore_free_data(store);
             return false;
         }
         
@@ -827,20 +3135,20 @@ bool datastore_load(DataStore* store, const char* filename) {
                 fread(sub->name, sizeof(char), 50, file) != 50 ||
                 fread(sub->description, sizeof(char), 200, file) != 200 ||
                 fread(&sub->product_count, sizeof(int), 1, file) != 1) {
-                set_color(COLOR_ERROR);
+                set_stream_color(stderr, COLOR_ERROR);
                 fprintf(stderr, "✗ Error: Failed to read subgroup %d\n", j);
-                set_color(COLOR_RESET);
+                set_stream_color(stderr, COLOR_RESET);
                 fclose(file);
-                datastore_free(store);
+                datastore_free_data(store);
                 return false;
             }
             
             if (sub->product_count < 0 || sub->product_count > 10000) {
-                set_color(COLOR_ERROR);
+                set_stream_color(stderr, COLOR_ERROR);
                 fprintf(stderr, "✗ Error: Invalid product count in subgroup\n");
-                set_color(COLOR_RESET);
+                set_stream_color(stderr, COLOR_RESET);
                 fclose(file);
-                datastore_free(store);
+                datastore_free_data(store);
                 return false;
             }
             
@@ -849,11 +3157,11 @@ bool datastore_load(DataStore* store, const char* filename) {
             sub->products = (Product*)malloc(sub->product_capacity * sizeof(Product));
             
             if (!sub->products) {
-                set_color(COLOR_ERROR);
+                set_stream_color(stderr, COLOR_ERROR);
                 fprintf(stderr, "✗ Error: Failed to allocate memory for products\n");
-                set_color(COLOR_RESET);
+                set_stream_color(stderr, COLOR_RESET);
                 fclose(file);
-                datastore_free(store);
+                datastore_free_data(store);
                 return false;
             }
             
@@ -861,11 +3169,19 @@ bool datastore_load(DataStore* store, const char* filename) {
             for (int k = 0; k < sub->product_count; k++) {
                 Product* prod = &sub->products[k];
                 if (fread(prod, sizeof(Product), 1, file) != 1) {
-                    set_color(COLOR_ERROR);
+                    set_stream_color(stderr, COLOR_ERROR);
                     fprintf(stderr, "✗ Error: Failed to read product %d\n", k);
-                    set_color(COLOR_RESET);
+                    set_stream_color(stderr, COLOR_RESET);
+                    fclose(file);
+                    datastore_free_data(store);
+                    return false;
+                }
+                if (prod->id <= 0) {
+                    set_stream_color(stderr, COLOR_ERROR);
+                    fprintf(stderr, "✗ Error: Invalid product ID %d\n", prod->id);
+                    set_stream_color(stderr, COLOR_RESET);
                     fclose(file);
-                    datastore_free(store);
+                    datastore_free_data(store);
                     return false;
                 }
             }
@@ -874,15 +3190,32 @@ bool datastore_load(DataStore* store, const char* filename) {
     
     fclose(file);
     
+    datastore_rebuild_handles(store);
+    store->version++;
+    
     get_current_timestamp(store->last_saved, sizeof(store->last_saved));
     store->is_modified = false;
     
+    if (store->snapshots) {
+        snapshot_invalidate_all(store->snapshots);
+        publish_snapshot(store);
+    }
+    
+    if (store->quiet) return true;
     set_color(COLOR_SUCCESS);
     printf("✓ Data loaded successfully from %s\n", filename);
     printf("  Categories: %d, Next IDs: Cat=%d, Sub=%d, Prod=%d\n",
-           store->category_count, store->next_category_id,
-           store->next_subgroup_id, store->next_product_id);
+           store->category_count, next_ids[0], next_ids[1], next_ids[2]);
     set_color(COLOR_RESET);
     
     return true;
+}
+
+bool datastore_load(DataStore* store, const char* filename) {
+    MetricTimer timer = METRICS_START();
+    datastore_write_lock(store);
+    bool ok = load_locked(store, filename);
+    datastore_write_unlock(store);
+    METRICS_STOP(METRIC_DATASTORE_LOAD, timer, ok);
+    return ok;
 }
\ No newline at end of file
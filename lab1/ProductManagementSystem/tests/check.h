@@ -0,0 +1,36 @@
+/**
+ * @file check.h
+ * @brief Minimal assertions for the tests/ programs
+ * @author PMS Team
+ * @date 2025
+ * @compatible Dev-C++ 6.3, TDM-GCC 9.2.0, C11
+ *
+ * Each test is a plain program: CHECK records a failure and keeps going,
+ * main returns check_result() so "make test" stops at the first failing
+ * program.
+ */
+
+#ifndef CHECK_H
+#define CHECK_H
+
+#include <stdio.h>
+
+static int check_failures = 0;
+
+#define CHECK(condition) \
+    do { \
+        if (!(condition)) { \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+            check_failures++; \
+        } \
+    } while (0)
+
+/**
+ * @brief Print a summary line and return the exit status for main
+ */
+static inline int check_result(const char* test_name) {
+    printf("%s: %s\n", test_name, check_failures == 0 ? "ok" : "FAILED");
+    return check_failures == 0 ? 0 : 1;
+}
+
+#endif // CHECK_H
@@ -0,0 +1,144 @@
+/**
+ * @file test_concurrency.c
+ * @brief Readers and writers sharing one DataStore
+ * @author PMS Team
+ * @date 2025
+ * @compatible Dev-C++ 6.3, TDM-GCC 9.2.0, C11
+ *
+ * Reader threads keep the shared lock held almost all the time, with their
+ * critical sections overlapping. Writers must still get the exclusive lock
+ * promptly instead of waiting for a gap between readers that never comes,
+ * and every write must be visible once they are done.
+ */
+
+#include "check.h"
+#include "utils.h"
+#include <stdatomic.h>
+#include <time.h>
+
+#define READER_COUNT 6
+#define WRITER_COUNT 2
+#define WRITES_PER_WRITER 200
+#define INITIAL_PRODUCTS 2000
+#define SUBGROUP_COUNT 4
+#define READ_HOLD_MS 0.2
+#define MAX_WRITE_WAIT_MS 1000.0
+#define DEADLINE_MS 20000.0
+
+typedef struct {
+    DataStore* store;
+    atomic_bool stop;
+    atomic_int writers_done;
+    atomic_long reads;
+    double max_write_wait_ms;    // Written by writers under the store's write lock
+} Shared;
+
+static double now_ms(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1e6;
+}
+
+static void reader(void* arg) {
+    Shared* shared = (Shared*)arg;
+
+    while (!atomic_load(&shared->stop)) {
+        datastore_read_lock(shared->store);
+        double until = now_ms() + READ_HOLD_MS;
+        while (now_ms() < until) {
+        }
+        datastore_read_unlock(shared->store);
+
+        // Searches take the same lock, alongside the raw holds above
+        SearchResult result = datastore_search_products_by_quantity(shared->store, 0, 5);
+        search_result_free(&result);
+        atomic_fetch_add(&shared->reads, 1);
+    }
+}
+
+static void writer(void* arg) {
+    Shared* shared = (Shared*)arg;
+
+    for (int i = 0; i < WRITES_PER_WRITER; i++) {
+        int id = datastore_allocate_id(shared->store, ID_PRODUCT);
+        int subgroup_id = 1 + id % SUBGROUP_COUNT;
+
+        double start = now_ms();
+        datastore_write_lock(shared->store);
+        double waited = now_ms() - start;
+        if (waited > shared->max_write_wait_ms) {
+            shared->max_write_wait_ms = waited;
+        }
+        datastore_write_unlock(shared->store);
+
+        Product product = product_create(id, subgroup_id, "W", "Written", "Added by a writer", 9.5f, 3);
+        CHECK(datastore_add_product(shared->store, subgroup_id, product));
+    }
+
+    atomic_fetch_add(&shared->writers_done, 1);
+}
+
+int main(void) {
+    DataStore store = datastore_init();
+    store.quiet = true;
+    CHECK(datastore_enable_concurrency(&store));
+
+    CHECK(datastore_add_category(&store, category_create(1, "Category", "Test")));
+    for (int s = 1; s <= SUBGROUP_COUNT; s++) {
+        CHECK(datastore_add_subgroup(&store, 1, subgroup_create(s, 1, "Subgroup", "Test")));
+    }
+    for (int i = 0; i < INITIAL_PRODUCTS; i++) {
+        int id = datastore_allocate_id(&store, ID_PRODUCT);
+        int subgroup_id = 1 + i % SUBGROUP_COUNT;
+        CHECK(datastore_add_product(&store, subgroup_id,
+                                    product_create(id, subgroup_id, "R", "Initial", "Seed", 1.0f, i % 10)));
+    }
+
+    Shared shared;
+    shared.store = &store;
+    atomic_init(&shared.stop, false);
+    atomic_init(&shared.writers_done, 0);
+    atomic_init(&shared.reads, 0);
+    shared.max_write_wait_ms = 0.0;
+
+    Thread readers[READER_COUNT];
+    Thread writers[WRITER_COUNT];
+    for (int i = 0; i < READER_COUNT; i++) {
+        CHECK(thread_create(&readers[i], reader, &shared));
+    }
+    for (int i = 0; i < WRITER_COUNT; i++) {
+        CHECK(thread_create(&writers[i], writer, &shared));
+    }
+
+    // A starved writer would never finish; stopping the readers frees it
+    double deadline = now_ms() + DEADLINE_MS;
+    while (atomic_load(&shared.writers_done) < WRITER_COUNT && now_ms() < deadline) {
+        SearchResult probe = datastore_search_products_by_price(&store, 0.0f, 0.5f);
+        search_result_free(&probe);
+    }
+    bool writers_finished = atomic_load(&shared.writers_done) == WRITER_COUNT;
+    atomic_store(&shared.stop, true);
+
+    for (int i = 0; i < WRITER_COUNT; i++) {
+        thread_join(writers[i]);
+    }
+    for (int i = 0; i < READER_COUNT; i++) {
+        thread_join(readers[i]);
+    }
+
+    CHECK(writers_finished);
+    CHECK(shared.max_write_wait_ms < MAX_WRITE_WAIT_MS);
+    CHECK(atomic_load(&shared.reads) > 0);
+
+    int expected = INITIAL_PRODUCTS + WRITER_COUNT * WRITES_PER_WRITER;
+    Statistics stats = datastore_get_statistics(&store);
+    CHECK(stats.total_products == expected);
+
+    SearchResult written = datastore_search_products_by_name(&store, "written");
+    CHECK(written.count == WRITER_COUNT * WRITES_PER_WRITER);
+    search_result_free(&written);
+
+    printf("reads: %ld, longest writer wait: %.1f ms\n", atomic_load(&shared.reads), shared.max_write_wait_ms);
+    datastore_free(&store);
+    return check_result("test_concurrency");
+}
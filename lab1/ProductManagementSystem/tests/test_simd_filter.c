@@ -0,0 +1,213 @@
+/**
+ * @file test_simd_filter.c
+ * @brief The AVX2, SSE2 and scalar filter kernels give identical results
+ * @author PMS Team
+ * @date 2025
+ * @compatible Dev-C++ 6.3, TDM-GCC 9.2.0, C11
+ *
+ * Every kernel this CPU supports is forced in turn and run over the same
+ * columns as the scalar kernel. Row counts cover every tail length of the
+ * 64-row bitmap word, and text fields cover every string length up to the
+ * full field, so the vector loops and their scalar tails are both checked.
+ * Results must match bit for bit, and the scalar kernel must match a plain
+ * reference loop.
+ */
+
+#include "check.h"
+#include "simd_filter.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_ROWS 300
+#define NAME_FIELD_SIZE 72         // Not a multiple of 16 or 32, like a real name column
+#define ROW_PADDING 8              // Rows are strided, as in an array of structs
+
+typedef struct {
+    char name[NAME_FIELD_SIZE];
+    char padding[ROW_PADDING];
+} TextRow;
+
+static const char* const VECTOR_KERNELS[] = { "avx2", "sse2" };
+
+static float prices[MAX_ROWS];
+static int quantities[MAX_ROWS];
+static TextRow rows[MAX_ROWS];
+
+static unsigned next_random(unsigned* state) {
+    *state = *state * 1103515245u + 12345u;
+    return (*state >> 16) & 0x7fff;
+}
+
+/**
+ * @brief Fill the columns; prices and quantities repeat so range bounds hit exact values
+ */
+static void fill_columns(unsigned seed) {
+    static const char ALPHABET[] = "abcABCxyzXYZ 09-\xc3\xa9";
+    unsigned state = seed;
+
+    for (int i = 0; i < MAX_ROWS; i++) {
+        prices[i] = (float)(next_random(&state) % 200) * 0.5f;
+        quantities[i] = (int)(next_random(&state) % 100) - 10;
+
+        // Every length from empty to a full field with no terminator
+        int length = i % (NAME_FIELD_SIZE + 1);
+        memset(&rows[i], 'q', sizeof(rows[i]));
+        for (int k = 0; k < length; k++) {
+            rows[i].name[k] = ALPHABET[next_random(&state) % (sizeof(ALPHABET) - 1)];
+        }
+        if (length < NAME_FIELD_SIZE) {
+            rows[i].name[length] = '\0';
+        }
+    }
+}
+
+static bool same_bitmap(const uint64_t* a, const uint64_t* b, int count) {
+    return memcmp(a, b, FILTER_BITMAP_WORDS(count) * sizeof(uint64_t)) == 0;
+}
+
+static int reference_price(int count, float min_price, float max_price, uint64_t* bitmap) {
+    int matches = 0;
+    memset(bitmap, 0, FILTER_BITMAP_WORDS(count) * sizeof(uint64_t));
+    for (int i = 0; i < count; i++) {
+        if (prices[i] >= min_price && prices[i] <= max_price) {
+            bitmap[i / 64] |= (uint64_t)1 << (i % 64);
+            matches++;
+        }
+    }
+    return matches;
+}
+
+static int reference_text(int count, const char* needle, uint64_t* bitmap) {
+    size_t needle_len = strlen(needle);
+    int matches = 0;
+
+    memset(bitmap, 0, FILTER_BITMAP_WORDS(count) * sizeof(uint64_t));
+    for (int i = 0; i < count; i++) {
+        const char* nul = (const char*)memchr(rows[i].name, '\0', NAME_FIELD_SIZE);
+        size_t length = nul ? (size_t)(nul - rows[i].name) : NAME_FIELD_SIZE;
+        bool found = needle_len == 0;
+
+        for (size_t start = 0; !found && start + needle_len <= length; start++) {
+            size_t k = 0;
+            while (k < needle_len) {
+                char c = rows[i].name[start + k];
+                if (c >= 'A' && c <= 'Z') c = (char)(c + ('a' - 'A'));
+                if (c != needle[k]) break;
+                k++;
+            }
+            found = k == needle_len;
+        }
+
+        if (found) {
+            bitmap[i / 64] |= (uint64_t)1 << (i % 64);
+            matches++;
+        }
+    }
+    return matches;
+}
+
+/**
+ * @brief Run every filter with the current kernel and compare against expected results
+ */
+static void compare_kernel(const char* kernel, bool against_reference) {
+    static const float PRICE_BOUNDS[][2] = { { 0.0f, 100.0f }, { 10.0f, 10.0f }, { 12.5f, 47.5f }, { 60.0f, 5.0f } };
+    static const int QUANTITY_BOUNDS[][2] = { { -10, 89 }, { 0, 0 }, { -3, 40 }, { 50, 20 } };
+    static const char* const NEEDLES[] = { "", "a", "ab", "abc", "zz", "x y", "-09", "\xc3\xa9", "cab",
+                                           "qqqq", "abcabcabcabcabcabc", "abcxyzabcxyzabcxyzabcxyzabcxyzabcx" };
+    uint64_t bitmap[FILTER_BITMAP_WORDS(MAX_ROWS)];
+    uint64_t expected[FILTER_BITMAP_WORDS(MAX_ROWS)];
+
+    for (int count = 1; count <= MAX_ROWS; count++) {
+        for (size_t b = 0; b < sizeof(PRICE_BOUNDS) / sizeof(PRICE_BOUNDS[0]); b++) {
+            float min_price = PRICE_BOUNDS[b][0];
+            float max_price = PRICE_BOUNDS[b][1];
+
+            CHECK(filter_force_kernel("scalar"));
+            int expected_matches = against_reference ?
+                reference_price(count, min_price, max_price, expected) :
+                filter_price_range(prices, count, min_price, max_price, expected);
+
+            CHECK(filter_force_kernel(kernel));
+            int matches = filter_price_range(prices, count, min_price, max_price, bitmap);
+            CHECK(matches == expected_matches && same_bitmap(bitmap, expected, count));
+        }
+
+        for (size_t b = 0; b < sizeof(QUANTITY_BOUNDS) / sizeof(QUANTITY_BOUNDS[0]); b++) {
+            int min_qty = QUANTITY_BOUNDS[b][0];
+            int max_qty = QUANTITY_BOUNDS[b][1];
+
+            CHECK(filter_force_kernel("scalar"));
+            int expected_matches = filter_quantity_range(quantities, count, min_qty, max_qty, expected);
+
+            CHECK(filter_force_kernel(kernel));
+            int matches = filter_quantity_range(quantities, count, min_qty, max_qty, bitmap);
+            CHECK(matches == expected_matches && same_bitmap(bitmap, expected, count));
+        }
+    }
+
+    // Every string length already shows up within the first NAME_FIELD_SIZE + 1 rows
+    for (size_t n = 0; n < sizeof(NEEDLES) / sizeof(NEEDLES[0]); n++) {
+        const char* needle = NEEDLES[n];
+        size_t needle_len = strlen(needle);
+
+        for (int count = 1; count <= MAX_ROWS; count += count < 2 * (NAME_FIELD_SIZE + 1) ? 1 : 37) {
+            CHECK(filter_force_kernel("scalar"));
+            int expected_matches = against_reference ?
+                reference_text(count, needle, expected) :
+                filter_text_contains(rows[0].name, sizeof(TextRow), NAME_FIELD_SIZE, count,
+                                     needle, needle_len, expected);
+
+            CHECK(filter_force_kernel(kernel));
+            int matches = filter_text_contains(rows[0].name, sizeof(TextRow), NAME_FIELD_SIZE, count,
+                                               needle, needle_len, bitmap);
+            CHECK(matches == expected_matches && same_bitmap(bitmap, expected, count));
+        }
+    }
+}
+
+/**
+ * @brief Place a needle at every offset of a full-length field
+ */
+static void compare_needle_positions(const char* kernel) {
+    static const char NEEDLE[] = "mixedcase";
+    uint64_t bitmap[1];
+
+    for (size_t offset = 0; offset + sizeof(NEEDLE) - 1 <= NAME_FIELD_SIZE; offset++) {
+        TextRow row;
+        memset(&row, 'q', sizeof(row));
+        memcpy(row.name + offset, "MiXeDcAsE", sizeof(NEEDLE) - 1);
+
+        CHECK(filter_force_kernel(kernel));
+        CHECK(filter_text_contains(row.name, sizeof(row), NAME_FIELD_SIZE, 1,
+                                   NEEDLE, sizeof(NEEDLE) - 1, bitmap) == 1);
+
+        // Cut the string one byte short of the needle: no match
+        row.name[offset + sizeof(NEEDLE) - 2] = '\0';
+        CHECK(filter_text_contains(row.name, sizeof(row), NAME_FIELD_SIZE, 1,
+                                   NEEDLE, sizeof(NEEDLE) - 1, bitmap) == 0);
+    }
+}
+
+int main(void) {
+    fill_columns(12345u);
+
+    CHECK(filter_force_kernel("scalar"));
+    CHECK(strcmp(filter_kernel_name(), "scalar") == 0);
+    compare_kernel("scalar", true);
+    compare_needle_positions("scalar");
+
+    for (size_t i = 0; i < sizeof(VECTOR_KERNELS) / sizeof(VECTOR_KERNELS[0]); i++) {
+        const char* kernel = VECTOR_KERNELS[i];
+        if (!filter_force_kernel(kernel)) {
+            printf("%s kernel not supported here, skipped\n", kernel);
+            continue;
+        }
+        CHECK(strcmp(filter_kernel_name(), kernel) == 0);
+        compare_kernel(kernel, false);
+        compare_needle_positions(kernel);
+    }
+
+    CHECK(!filter_force_kernel("neon"));
+    CHECK(filter_force_kernel(NULL));
+    return check_result("test_simd_filter");
+}
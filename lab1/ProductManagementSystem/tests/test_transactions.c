@@ -0,0 +1,218 @@
+/**
+ * @file test_transactions.c
+ * @brief Aborted transactions restore the store exactly
+ * @author PMS Team
+ * @date 2025
+ * @compatible Dev-C++ 6.3, TDM-GCC 9.2.0, C11
+ *
+ * One transaction adds, removes, moves and updates entities across several
+ * categories and subgroups and is then aborted. The whole tree, in array
+ * order, must match a copy taken before it began, and every lookup path
+ * (ID, handle, scan table) must agree with it.
+ */
+
+#include "check.h"
+#include "utils.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define CATEGORY_COUNT 3
+#define SUBGROUPS_PER_CATEGORY 3
+#define PRODUCTS_PER_SUBGROUP 8
+
+/**
+ * @brief Flattened copy of a store, in array order
+ */
+typedef struct {
+    Category categories[16];
+    Subgroup subgroups[64];
+    Product products[512];
+    int category_count;
+    int subgroup_count;
+    int product_count;
+} TreeCopy;
+
+static void copy_tree(const DataStore* store, TreeCopy* copy) {
+    memset(copy, 0, sizeof(*copy));
+
+    for (int i = 0; i < store->category_count; i++) {
+        const Category* cat = &store->categories[i];
+        copy->categories[copy->category_count++] = *cat;
+
+        for (int j = 0; j < cat->subgroup_count; j++) {
+            const Subgroup* sub = &cat->subgroups[j];
+            copy->subgroups[copy->subgroup_count++] = *sub;
+
+            for (int k = 0; k < sub->product_count; k++) {
+                copy->products[copy->product_count++] = sub->products[k];
+            }
+        }
+    }
+}
+
+/**
+ * @brief Compare two copies field by field, ignoring array pointers and capacities
+ */
+static bool same_tree(const TreeCopy* a, const TreeCopy* b) {
+    if (a->category_count != b->category_count || a->subgroup_count != b->subgroup_count ||
+        a->product_count != b->product_count) {
+        return false;
+    }
+
+    for (int i = 0; i < a->category_count; i++) {
+        const Category* x = &a->categories[i];
+        const Category* y = &b->categories[i];
+        if (x->id != y->id || x->subgroup_count != y->subgroup_count ||
+            strcmp(x->name, y->name) != 0 || strcmp(x->description, y->description) != 0) {
+            return false;
+        }
+    }
+
+    for (int i = 0; i < a->subgroup_count; i++) {
+        const Subgroup* x = &a->subgroups[i];
+        const Subgroup* y = &b->subgroups[i];
+        if (x->id != y->id || x->category_id != y->category_id || x->product_count != y->product_count ||
+            strcmp(x->name, y->name) != 0 || strcmp(x->description, y->description) != 0) {
+            return false;
+        }
+    }
+
+    return memcmp(a->products, b->products, a->product_count * sizeof(Product)) == 0;
+}
+
+/**
+ * @brief Every product is found by ID and handle, and the scan table holds exactly the tree
+ */
+static void check_lookups(DataStore* store, const TreeCopy* copy) {
+    for (int i = 0; i < copy->product_count; i++) {
+        const Product* expected = &copy->products[i];
+        Product* by_id = datastore_find_product_by_id(store, expected->id);
+        CHECK(by_id && memcmp(by_id, expected, sizeof(Product)) == 0);
+
+        ProductHandle handle = datastore_get_product_handle(store, expected->id);
+        CHECK(datastore_resolve_product(store, handle) == by_id);
+    }
+
+    for (int i = 0; i < copy->subgroup_count; i++) {
+        Subgroup* sub = datastore_find_subgroup_by_id(store, copy->subgroups[i].id);
+        CHECK(sub && sub->product_count == copy->subgroups[i].product_count);
+    }
+
+    SearchResult all = datastore_search_products_by_price(store, -1.0f, 1e9f);
+    CHECK(all.count == copy->product_count);
+    search_result_free(&all);
+
+    Statistics stats = datastore_get_statistics(store);
+    CHECK(stats.total_categories == copy->category_count);
+    CHECK(stats.total_subgroups == copy->subgroup_count);
+    CHECK(stats.total_products == copy->product_count);
+}
+
+static void build_store(DataStore* store) {
+    for (int c = 1; c <= CATEGORY_COUNT; c++) {
+        CHECK(datastore_add_category(store, category_create(c, "Category", "Original")));
+
+        for (int s = 0; s < SUBGROUPS_PER_CATEGORY; s++) {
+            int subgroup_id = c * 10 + s;
+            CHECK(datastore_add_subgroup(store, c, subgroup_create(subgroup_id, c, "Subgroup", "Original")));
+
+            for (int p = 0; p < PRODUCTS_PER_SUBGROUP; p++) {
+                int id = subgroup_id * 100 + p;
+                CHECK(datastore_add_product(store, subgroup_id,
+                                            product_create(id, subgroup_id, "CODE", "Original product",
+                                                           "Seed", 1.0f + p, p)));
+            }
+        }
+    }
+}
+
+static void test_abort_restores_tree(void) {
+    DataStore store = datastore_init();
+    store.quiet = true;
+    build_store(&store);
+
+    // Build the scan table first so the abort has to patch it, not just drop it
+    SearchResult warm = datastore_search_products_by_name(&store, "original");
+    search_result_free(&warm);
+
+    TreeCopy before;
+    copy_tree(&store, &before);
+
+    DataStoreTxn txn;
+    CHECK(datastore_txn_begin(&txn, &store));
+
+    // New category with its own subgroup and products
+    CHECK(datastore_txn_add_category(&txn, category_create(9, "Added", "In transaction")));
+    CHECK(datastore_txn_add_subgroup(&txn, 9, subgroup_create(90, 9, "Added", "In transaction")));
+    CHECK(datastore_txn_add_product(&txn, 90, product_create(9001, 90, "NEW", "Added", "Txn", 5.0f, 5)));
+
+    // Removals at the front, middle and end of arrays at every level
+    CHECK(datastore_txn_remove_product(&txn, 1000));
+    CHECK(datastore_txn_remove_product(&txn, 1104));
+    CHECK(datastore_txn_remove_product(&txn, 1207));
+    CHECK(datastore_txn_remove_subgroup(&txn, 21));
+    CHECK(datastore_txn_remove_category(&txn, 1));
+
+    // Moves between subgroups of different categories, including into the new one
+    CHECK(datastore_txn_move_product(&txn, 2003, 30));
+    CHECK(datastore_txn_move_product(&txn, 3105, 90));
+    CHECK(datastore_txn_move_product(&txn, 2201, 32));
+
+    // Updates, one of them to a product that was moved first
+    Product update = product_create(3001, 30, "UPD", "Updated", "Txn", 99.0f, 42);
+    CHECK(datastore_txn_update_product(&txn, update));
+    update = product_create(2003, 30, "UPD", "Updated again", "Txn", 77.0f, 7);
+    CHECK(datastore_txn_update_product(&txn, update));
+
+    // More adds into existing subgroups after all of the above
+    CHECK(datastore_txn_add_product(&txn, 32, product_create(9002, 32, "NEW", "Added", "Txn", 6.0f, 6)));
+    CHECK(datastore_txn_add_subgroup(&txn, 3, subgroup_create(39, 3, "Added", "In transaction")));
+
+    TreeCopy during;
+    copy_tree(&store, &during);
+    CHECK(!same_tree(&before, &during));
+
+    datastore_txn_abort(&txn);
+
+    TreeCopy after;
+    copy_tree(&store, &after);
+    CHECK(same_tree(&before, &after));
+    check_lookups(&store, &before);
+
+    // The same store keeps working after the abort
+    CHECK(datastore_add_product(&store, 10, product_create(9003, 10, "NEW", "After", "Abort", 1.0f, 1)));
+    CHECK(datastore_find_product_by_id(&store, 9003) != NULL);
+
+    datastore_free(&store);
+}
+
+static void test_update_stamps_product(void) {
+    DataStore store = datastore_init();
+    store.quiet = true;
+    build_store(&store);
+
+    Product original = *datastore_find_product_by_id(&store, 1001);
+
+    DataStoreTxn txn;
+    CHECK(datastore_txn_begin(&txn, &store));
+    Product update = original;
+    strcpy(update.name, "Renamed");
+    strcpy(update.created_at, "2000-01-01 00:00:00");
+    strcpy(update.updated_at, "2000-01-01 00:00:00");
+    CHECK(datastore_txn_update_product(&txn, update));
+    CHECK(datastore_txn_commit(&txn));
+
+    const Product* updated = datastore_find_product_by_id(&store, 1001);
+    CHECK(updated && strcmp(updated->name, "Renamed") == 0);
+    CHECK(updated && strcmp(updated->created_at, original.created_at) == 0);
+    CHECK(updated && strcmp(updated->updated_at, "2000-01-01 00:00:00") != 0);
+    CHECK(updated && updated->updated_at[0] != '\0');
+
+    datastore_free(&store);
+}
+
+int main(void) {
+    test_abort_restores_tree();
+    test_update_stamps_product();
+    return check_result("test_transactions");
+}
@@ -0,0 +1,525 @@
+/**
+ * @file gen_catalog.c
+ * @brief Synthetic catalog generator for scale testing
+ * @author PMS Team
+ * @date 2025
+ * @compatible Dev-C++ 6.3, TDM-GCC 9.2.0, C11
+ *
+ * Writes a data file in the datastore_save format without building a store,
+ * so catalogs of millions of products are produced at close to disk speed.
+ * The output depends only on the options and the seed: the same command
+ * always writes the same bytes.
+ *
+ * The catalog is shaped like a real one rather than a uniform grid:
+ *   - subgroup sizes follow a Pareto distribution (a few large, many small)
+ *   - names and descriptions are assembled from word lists, 15-60 and
+ *     40-199 characters long
+ *   - prices are log-normal around a per-subgroup price level
+ *   - quantities are log-normal with a share of out-of-stock products
+ *
+ * Counts are kept inside the datastore_load limits: at most 10000
+ * categories, 1000 subgroups per category and 10000 products per subgroup.
+ *
+ * Usage: gen_catalog [--products N] [--subgroups N] [--categories N]
+ *                    [--seed N] [--skew A] [--out FILE] [--verify]
+ */
+
+#include "../include/utils.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#include <time.h>
+
+#define MAX_CATEGORIES 10000
+#define MAX_SUBGROUPS_PER_CATEGORY 1000
+#define MAX_PRODUCTS_PER_SUBGROUP 10000
+#define WRITE_BUFFER_SIZE (4 * 1024 * 1024)
+#define OUT_OF_STOCK_PERCENT 8
+
+// 2024-01-01 00:00:00 UTC; creation times fall in the two years after it
+#define BASE_EPOCH 1704067200LL
+#define TIME_SPAN (2LL * 365 * 24 * 3600)
+
+typedef struct {
+    long long products;
+    int subgroups;
+    int categories;
+    uint64_t seed;
+    double skew;               // Pareto shape of subgroup sizes, lower is more skewed
+    const char* out;
+    bool verify;
+} GenOptions;
+
+// ============================================================================
+// Random Numbers
+// ============================================================================
+
+// xoshiro256**, seeded through splitmix64; fixed output on every platform
+static uint64_t rng[4];
+
+static uint64_t splitmix64(uint64_t* state) {
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+static void rng_seed(uint64_t seed) {
+    for (int i = 0; i < 4; i++) {
+        rng[i] = splitmix64(&seed);
+    }
+}
+
+static uint64_t rotl(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+static uint64_t rng_next(void) {
+    uint64_t result = rotl(rng[1] * 5, 7) * 9;
+    uint64_t t = rng[1] << 17;
+    rng[2] ^= rng[0];
+    rng[3] ^= rng[1];
+    rng[1] ^= rng[2];
+    rng[0] ^= rng[3];
+    rng[2] ^= t;
+    rng[3] = rotl(rng[3], 45);
+    return result;
+}
+
+static uint32_t rng_below(uint32_t bound) {
+    return (uint32_t)(((rng_next() >> 32) * bound) >> 32);
+}
+
+/**
+ * @brief Uniform double in (0, 1]
+ */
+static double rng_unit(void) {
+    return ((rng_next() >> 11) + 1) * (1.0 / 9007199254740992.0);
+}
+
+static double rng_normal(void) {
+    // Box-Muller; the second value is dropped to keep the sequence simple
+    double u = rng_unit();
+    double v = rng_unit();
+    return sqrt(-2.0 * log(u)) * cos(6.283185307179586 * v);
+}
+
+// ============================================================================
+// Word Lists
+// ============================================================================
+
+#define COUNT_OF(array) ((int)(sizeof(array) / sizeof((array)[0])))
+
+static const char* const departments[] = {
+    "Electronics", "Home", "Garden", "Tools", "Sports", "Toys", "Grocery",
+    "Beauty", "Health", "Automotive", "Office", "Books", "Music", "Pets",
+    "Baby", "Clothing", "Shoes", "Jewelry", "Kitchen", "Outdoor"
+};
+
+static const char* const brands[] = {
+    "Acme", "Northwind", "Contoso", "Fabrikam", "Globex", "Initech", "Umbrella",
+    "Stark", "Wayne", "Tyrell", "Cyberdyne", "Vandelay", "Wonka", "Soylent",
+    "Hooli", "Pied Piper", "Aperture", "Black Mesa", "Oceanic", "Massive Dynamic"
+};
+
+static const char* const adjectives[] = {
+    "Compact", "Deluxe", "Portable", "Wireless", "Heavy-Duty", "Classic", "Smart",
+    "Ultra", "Premium", "Eco", "Mini", "Professional", "Foldable", "Rechargeable",
+    "Stainless", "Waterproof", "Ergonomic", "Vintage", "Modular", "Lightweight"
+};
+
+static const char* const materials[] = {
+    "Steel", "Bamboo", "Ceramic", "Carbon", "Leather", "Cotton", "Glass",
+    "Aluminium", "Oak", "Silicone", "Titanium", "Wool", "Copper", "Nylon"
+};
+
+static const char* const nouns[] = {
+    "Drill", "Kettle", "Lamp", "Backpack", "Speaker", "Blender", "Chair", "Desk",
+    "Headphones", "Jacket", "Notebook", "Bottle", "Router", "Camera", "Mixer",
+    "Toaster", "Monitor", "Keyboard", "Tent", "Helmet", "Watch", "Vacuum",
+    "Scale", "Grill", "Fan", "Heater", "Charger", "Cable", "Mat", "Organizer"
+};
+
+static const char* const phrases[] = {
+    "Built for everyday use.",
+    "Ships in recyclable packaging.",
+    "Backed by a two-year limited warranty.",
+    "Easy to clean and quick to assemble.",
+    "Designed for small spaces.",
+    "Tested to withstand daily wear and tear.",
+    "Includes all mounting hardware.",
+    "Energy efficient with a low standby draw.",
+    "Available while stocks last.",
+    "A customer favourite for over a decade.",
+    "Compatible with most standard accessories.",
+    "Replacement parts are sold separately.",
+    "Hand finished by skilled craftspeople.",
+    "Suitable for indoor and outdoor use."
+};
+
+#define PICK(list) (list[rng_below((uint32_t)COUNT_OF(list))])
+
+// ============================================================================
+// Record Generation
+// ============================================================================
+
+/**
+ * @brief Format Unix time as "YYYY-MM-DD HH:MM:SS" without the C library's time zone
+ */
+static void format_timestamp(long long t, char* buffer) {
+    long long days = t / 86400;
+    int seconds = (int)(t % 86400);
+
+    // Days since 1970-01-01 to a civil date (proleptic Gregorian)
+    long long z = days + 719468;
+    long long era = z / 146097;
+    long long doe = z - era * 146097;
+    long long yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    long long doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    long long mp = (5 * doy + 2) / 153;
+    int day = (int)(doy - (153 * mp + 2) / 5 + 1);
+    int month = (int)(mp < 10 ? mp + 3 : mp - 9);
+    int year = (int)(yoe + era * 400 + (month <= 2));
+
+    // Written digit by digit: this runs twice per product
+    int fields[6] = { year / 100, year % 100, month, day, seconds / 3600, seconds / 60 % 60 };
+    static const char separators[6] = { 0, 0, '-', '-', ' ', ':' };
+    char* out = buffer;
+    for (int i = 0; i < 6; i++) {
+        if (separators[i]) *out++ = separators[i];
+        *out++ = (char)('0' + fields[i] / 10);
+        *out++ = (char)('0' + fields[i] % 10);
+    }
+    *out++ = ':';
+    *out++ = (char)('0' + seconds % 60 / 10);
+    *out++ = (char)('0' + seconds % 10);
+    *out = '\0';
+}
+
+static void make_description(char* buffer, size_t size, const char* lead) {
+    int length = snprintf(buffer, size, "%s", lead);
+    int sentences = 1 + (int)rng_below(4);
+
+    for (int i = 0; i < sentences; i++) {
+        const char* phrase = PICK(phrases);
+        if (length + 1 + (int)strlen(phrase) >= (int)size) break;
+        length += snprintf(buffer + length, size - length, " %s", phrase);
+    }
+}
+
+static void make_product(Product* product, int id, int subgroup_id, double price_level) {
+    memset(product, 0, sizeof(*product));
+    product->id = id;
+    product->subgroup_id = subgroup_id;
+    snprintf(product->code, sizeof(product->code), "SKU-%09d", id);
+
+    // 15-60 characters: brand, up to two qualifiers, noun and model number
+    int length = snprintf(product->name, sizeof(product->name), "%s", PICK(brands));
+    if (rng_below(3) != 0) {
+        length += snprintf(product->name + length, sizeof(product->name) - length, " %s", PICK(adjectives));
+    }
+    if (rng_below(2) == 0) {
+        length += snprintf(product->name + length, sizeof(product->name) - length, " %s", PICK(materials));
+    }
+    snprintf(product->name + length, sizeof(product->name) - length, " %s %c%u",
+             PICK(nouns), 'A' + (char)rng_below(26), 100 + rng_below(9900));
+
+    char lead[64];
+    snprintf(lead, sizeof(lead), "%s %s.", PICK(adjectives), PICK(nouns));
+    make_description(product->description, sizeof(product->description), lead);
+
+    double price = exp(price_level + 0.6 * rng_normal());
+    if (price < 0.5) price = 0.5;
+    if (price > 99999.0) price = 99999.0;
+    product->price = (float)(floor(price * 100.0 + 0.5) / 100.0);
+
+    if ((int)rng_below(100) < OUT_OF_STOCK_PERCENT) {
+        product->quantity = 0;
+    } else {
+        double quantity = exp(3.0 + 1.2 * rng_normal());
+        product->quantity = quantity < 1.0 ? 1 : quantity > 100000.0 ? 100000 : (int)quantity;
+    }
+
+    long long created = BASE_EPOCH + (long long)(rng_unit() * TIME_SPAN);
+    long long updated = created + (long long)(rng_unit() * (BASE_EPOCH + TIME_SPAN - created));
+    format_timestamp(created, product->created_at);
+    format_timestamp(updated, product->updated_at);
+}
+
+/**
+ * @brief Split the products over the subgroups with Pareto-distributed sizes
+ * @return Array of subgroup sizes, NULL on allocation failure
+ */
+static int* subgroup_sizes(const GenOptions* options) {
+    int count = options->subgroups;
+    int* sizes = (int*)malloc((size_t)count * sizeof(int));
+    double* weights = (double*)malloc((size_t)count * sizeof(double));
+    if (!sizes || !weights) {
+        free(sizes);
+        free(weights);
+        return NULL;
+    }
+
+    double total_weight = 0.0;
+    for (int i = 0; i < count; i++) {
+        weights[i] = pow(rng_unit(), -1.0 / options->skew);
+        total_weight += weights[i];
+    }
+
+    long long assigned = 0;
+    for (int i = 0; i < count; i++) {
+        long long size = (long long)(options->products * (weights[i] / total_weight));
+        sizes[i] = (int)(size > MAX_PRODUCTS_PER_SUBGROUP ? MAX_PRODUCTS_PER_SUBGROUP : size);
+        assigned += sizes[i];
+    }
+    free(weights);
+
+    // Rounding and the per-subgroup cap leave a remainder; spread it evenly
+    while (assigned < options->products) {
+        long long share = (options->products - assigned + count - 1) / count;
+        for (int i = 0; i < count && assigned < options->products; i++) {
+            long long room = MAX_PRODUCTS_PER_SUBGROUP - sizes[i];
+            long long take = share < room ? share : room;
+            if (take > options->products - assigned) take = options->products - assigned;
+            sizes[i] += (int)take;
+            assigned += take;
+        }
+    }
+    return sizes;
+}
+
+// ============================================================================
+// File Output
+// ============================================================================
+
+static long long now_ns(void) {
+    struct timespec ts;
+    #ifdef CLOCK_MONOTONIC
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    #else
+    timespec_get(&ts, TIME_UTC);
+    #endif
+    return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+static bool write_int(FILE* file, int value) {
+    return fwrite(&value, sizeof(int), 1, file) == 1;
+}
+
+/**
+ * @brief Write a category (parent_id 0) or subgroup header
+ */
+static bool write_group(FILE* file, int id, int parent_id, const char* name,
+                        const char* description, int child_count) {
+    char name_field[50] = {0};
+    char description_field[200] = {0};
+    snprintf(name_field, sizeof(name_field), "%s", name);
+    snprintf(description_field, sizeof(description_field), "%s", description);
+
+    return write_int(file, id) &&
+           (parent_id == 0 || write_int(file, parent_id)) &&
+           fwrite(name_field, sizeof(char), 50, file) == 50 &&
+           fwrite(description_field, sizeof(char), 200, file) == 200 &&
+           write_int(file, child_count);
+}
+
+static bool generate(const GenOptions* options, FILE* file) {
+    rng_seed(options->seed);
+
+    int* sizes = subgroup_sizes(options);
+    if (!sizes) {
+        fprintf(stderr, "Error: Failed to allocate memory for subgroup sizes\n");
+        return false;
+    }
+
+    bool ok = write_int(file, options->categories) &&
+              write_int(file, options->categories + 1) &&
+              write_int(file, options->subgroups + 1) &&
+              write_int(file, (int)options->products + 1);
+
+    Product product;
+    char name[50];
+    char description[200];
+    int subgroup_index = 0;
+    int product_id = 1;
+
+    for (int c = 0; c < options->categories && ok; c++) {
+        // Subgroups are spread evenly, the first categories take the remainder
+        int subgroup_count = options->subgroups / options->categories +
+                             (c < options->subgroups % options->categories ? 1 : 0);
+        const char* department = departments[c % COUNT_OF(departments)];
+
+        snprintf(name, sizeof(name), "%s %d", department, c + 1);
+        snprintf(description, sizeof(description), "%s department, %d subgroups", department, subgroup_count);
+        ok = write_group(file, c + 1, 0, name, description, subgroup_count);
+
+        for (int s = 0; s < subgroup_count && ok; s++, subgroup_index++) {
+            int subgroup_id = subgroup_index + 1;
+            const char* noun = PICK(nouns);
+            double price_level = log(5.0) + rng_unit() * (log(500.0) - log(5.0));
+
+            snprintf(name, sizeof(name), "%ss %d", noun, subgroup_id);
+            make_description(description, sizeof(description), department);
+            ok = write_group(file, subgroup_id, c + 1, name, description, sizes[subgroup_index]);
+
+            for (int p = 0; p < sizes[subgroup_index] && ok; p++) {
+                make_product(&product, product_id++, subgroup_id, price_level);
+                ok = fwrite(&product, sizeof(product), 1, file) == 1;
+            }
+        }
+    }
+
+    free(sizes);
+    if (!ok) {
+        fprintf(stderr, "Error: Failed to write %s\n", options->out);
+    }
+    return ok;
+}
+
+/**
+ * @brief Load the file back with datastore_load and compare the counts
+ */
+static bool verify(const GenOptions* options) {
+    DataStore store = datastore_init();
+    store.quiet = true;
+
+    bool ok = datastore_load(&store, options->out);
+    if (ok) {
+        Statistics stats = datastore_get_statistics(&store);
+        ok = stats.total_categories == options->categories &&
+             stats.total_subgroups == options->subgroups &&
+             stats.total_products == options->products;
+        if (!ok) {
+            fprintf(stderr, "Error: Loaded %d categories, %d subgroups, %d products\n",
+                    stats.total_categories, stats.total_subgroups, stats.total_products);
+        }
+    }
+
+    datastore_free(&store);
+    return ok;
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+static bool check_options(GenOptions* options) {
+    if (options->products < 0 || options->products >= 2147483647LL) {
+        fprintf(stderr, "Error: Product count must be between 0 and 2147483646\n");
+        return false;
+    }
+
+    // Fill in defaults: about 500 products per subgroup, 40 subgroups per category
+    if (options->subgroups <= 0) {
+        long long subgroups = options->products / 500;
+        long long needed = (options->products + MAX_PRODUCTS_PER_SUBGROUP - 1) / MAX_PRODUCTS_PER_SUBGROUP;
+        if (subgroups < needed) subgroups = needed;
+        if (subgroups > (long long)MAX_CATEGORIES * MAX_SUBGROUPS_PER_CATEGORY) {
+            subgroups = (long long)MAX_CATEGORIES * MAX_SUBGROUPS_PER_CATEGORY;
+        }
+        options->subgroups = subgroups > 0 ? (int)subgroups : 1;
+    }
+    if (options->categories <= 0) {
+        int categories = options->subgroups / 40;
+        int needed = (options->subgroups + MAX_SUBGROUPS_PER_CATEGORY - 1) / MAX_SUBGROUPS_PER_CATEGORY;
+        if (categories < needed) categories = needed;
+        if (categories > MAX_CATEGORIES) categories = MAX_CATEGORIES;
+        options->categories = categories > 0 ? categories : 1;
+    }
+
+    if (options->categories > MAX_CATEGORIES) {
+        fprintf(stderr, "Error: At most %d categories can be loaded\n", MAX_CATEGORIES);
+        return false;
+    }
+    if ((long long)options->subgroups > (long long)options->categories * MAX_SUBGROUPS_PER_CATEGORY) {
+        fprintf(stderr, "Error: %d categories hold at most %lld subgroups\n",
+                options->categories, (long long)options->categories * MAX_SUBGROUPS_PER_CATEGORY);
+        return false;
+    }
+    if (options->products > (long long)options->subgroups * MAX_PRODUCTS_PER_SUBGROUP) {
+        fprintf(stderr, "Error: %d subgroups hold at most %lld products\n",
+                options->subgroups, (long long)options->subgroups * MAX_PRODUCTS_PER_SUBGROUP);
+        return false;
+    }
+    if (options->skew <= 0.0) {
+        fprintf(stderr, "Error: Skew must be positive\n");
+        return false;
+    }
+    return true;
+}
+
+static void print_usage(const char* program) {
+    fprintf(stderr, "Usage: %s [--products N] [--subgroups N] [--categories N]\n", program);
+    fprintf(stderr, "          [--seed N] [--skew A] [--out FILE] [--verify]\n");
+    fprintf(stderr, "Defaults: 1000000 products, 500 per subgroup on average, 40 subgroups\n");
+    fprintf(stderr, "per category, seed 1, skew 1.5, output catalog.dat\n");
+}
+
+int main(int argc, char* argv[]) {
+    GenOptions options;
+    options.products = 1000000;
+    options.subgroups = 0;
+    options.categories = 0;
+    options.seed = 1;
+    options.skew = 1.5;
+    options.out = "catalog.dat";
+    options.verify = false;
+
+    for (int i = 1; i < argc; i++) {
+        bool has_value = i + 1 < argc;
+
+        if (strcmp(argv[i], "--products") == 0 && has_value) {
+            options.products = atoll(argv[++i]);
+        } else if (strcmp(argv[i], "--subgroups") == 0 && has_value) {
+            options.subgroups = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--categories") == 0 && has_value) {
+            options.categories = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--seed") == 0 && has_value) {
+            options.seed = strtoull(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--skew") == 0 && has_value) {
+            options.skew = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--out") == 0 && has_value) {
+            options.out = argv[++i];
+        } else if (strcmp(argv[i], "--verify") == 0) {
+            options.verify = true;
+        } else {
+            print_usage(argv[0]);
+            return 2;
+        }
+    }
+
+    if (!check_options(&options)) return 2;
+
+    FILE* file = fopen(options.out, "wb");
+    if (!file) {
+        fprintf(stderr, "Error: Cannot create %s\n", options.out);
+        return 1;
+    }
+    setvbuf(file, NULL, _IOFBF, WRITE_BUFFER_SIZE);
+
+    long long start = now_ns();
+    bool ok = generate(&options, file);
+    if (fclose(file) != 0) ok = false;
+    if (!ok) {
+        remove(options.out);
+        return 1;
+    }
+    double seconds = (now_ns() - start) / 1e9;
+
+    long long bytes = 16 + options.categories * 258LL + options.subgroups * 262LL +
+                      options.products * (long long)sizeof(Product);
+    printf("%s: %d categories, %d subgroups, %lld products, %.1f MB in %.2f s (%.0f MB/s)\n",
+           options.out, options.categories, options.subgroups, options.products,
+           bytes / 1e6, seconds, seconds > 0 ? bytes / 1e6 / seconds : 0.0);
+
+    if (options.verify) {
+        if (!verify(&options)) {
+            fprintf(stderr, "Error: %s did not load back as generated\n", options.out);
+            return 1;
+        }
+        printf("Verified: loads with the generated counts\n");
+    }
+    return 0;
+}